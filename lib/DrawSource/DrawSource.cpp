@@ -0,0 +1,50 @@
+/**
+ * @file DrawSource.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Interface das fontes dos números sorteados pela roleta
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "DrawSource.h"
+
+/**
+ * @brief Constrói um novo objeto DrawSource
+ * 
+ */
+DrawSource::DrawSource(){
+    this->ledsCount = 0;
+}
+
+/**
+ * @brief Inicializa a fonte. Chamada por ElectronicRoulette::begin()
+ * 
+ * @param ledsCount Quantidade de leds da roleta
+ */
+void DrawSource::begin(uint8_t ledsCount){
+    this->ledsCount = ledsCount;
+}
+
+/**
+ * @brief Acrescenta um número ao fim da sequência. As fontes que não recebem números recusam
+ * 
+ * @param led Led a ser sorteado (0 a ledsCount - 1)
+ * @return true Se o número foi acrescentado
+ * @return false Se a fonte está cheia ou não recebe números
+ */
+bool DrawSource::push(uint8_t led){
+    (void)led;
+    return false;
+}
+
+/**
+ * @brief Obtém quantos números ainda podem ser acrescentados com push()
+ * 
+ * @return uint16_t Espaço livre (0 para as fontes que não recebem números)
+ */
+uint16_t DrawSource::space(){
+    return 0;
+}
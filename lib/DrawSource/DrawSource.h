@@ -0,0 +1,71 @@
+/**
+ * @file DrawSource.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Interface das fontes dos números sorteados pela roleta
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * A roleta pede um número à fonte no início de cada sorteio, sob demanda.
+ * As fontes guardam o índice do led (0 a ledsCount - 1). As que guardam
+ * sequências em memória aceitam o formato compactado, com dois números por
+ * byte (nibble baixo primeiro), que serve para roletas de até 16 leds.
+ * 
+ */
+
+#ifndef __DRAWSOURCE__H__
+#define __DRAWSOURCE__H__
+
+#include "hal.h"
+
+#define DRAW_SOURCE_EMPTY 0xFF              //!< Retornado por next() quando não há número disponível
+#define DRAW_SOURCE_PACKED_LEDS 16          //!< Quantidade máxima de leds para o formato compactado
+
+/**
+ * @brief Monta um byte do formato compactado, para escrever tabelas (ex.: em PROGMEM)
+ * 
+ * @param first Led do primeiro sorteio (0 a 15)
+ * @param second Led do sorteio seguinte (0 a 15)
+ */
+#define DRAW_SOURCE_PACK(first, second) ((uint8_t)(((first) & 0x0F) | ((second) & 0x0F) << 4))
+
+/**
+ * @brief Fonte dos números sorteados
+ */
+class DrawSource
+{
+protected:
+    uint8_t ledsCount;                              //!< Quantidade de leds da roleta
+    /**
+     * @brief Obtém a posição do byte que guarda um número
+     * 
+     * @param index Índice do número na sequência
+     * @param packed Indica o formato compactado
+     * @return uint16_t Posição do byte
+     */
+    static uint16_t byteIndex(uint16_t index, bool packed){
+        return packed ? index >> 1 : index;
+    }
+    /**
+     * @brief Extrai um número do byte que o guarda
+     * 
+     * @param data Byte lido da memória
+     * @param index Índice do número na sequência
+     * @param packed Indica o formato compactado
+     * @return uint8_t Led sorteado
+     */
+    static uint8_t unpack(uint8_t data, uint16_t index, bool packed){
+        if(!packed) return data;
+        return index & 1 ? data >> 4 : data & 0x0F;
+    }
+public:
+    DrawSource();
+    virtual ~DrawSource() {}
+    virtual void begin(uint8_t ledsCount);
+    virtual uint8_t next() = 0;
+    virtual bool push(uint8_t led);
+    virtual uint16_t space();
+};
+
+#endif  //!__DRAWSOURCE__H__
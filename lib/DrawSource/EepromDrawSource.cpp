@@ -0,0 +1,127 @@
+/**
+ * @file EepromDrawSource.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fonte de números gravados na EEPROM
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "EepromDrawSource.h"
+
+#ifdef ARDUINO
+#include <EEPROM.h>
+#endif
+
+/**
+ * Métodos públicos
+ */
+
+/**
+ * @brief Constrói um novo objeto EepromDrawSource
+ * 
+ * @param address Endereço do primeiro byte da sequência
+ * @param count Quantidade de números da sequência (no formato compactado, o dobro da quantidade de bytes)
+ * @param packed Indica que a sequência guarda dois números por byte
+ * @param positionAddress Endereço onde a posição é gravada a cada sorteio (DRAW_SOURCE_NO_ADDRESS = não grava)
+ * @param positionSlots Cópias da posição (1 a 255), ocupando DRAW_SOURCE_SLOT_SIZE * positionSlots bytes a partir de
+ * positionAddress. Cada sorteio escreve até 3 bytes de uma única cópia, então a EEPROM suporta cerca de
+ * 100.000 * positionSlots sorteios
+ */
+EepromDrawSource::EepromDrawSource(uint16_t address, uint16_t count, bool packed, uint16_t positionAddress, uint8_t positionSlots){
+    this->address = address;
+    this->count = count;
+    this->packed = packed;
+    this->positionAddress = positionAddress;
+    this->positionSlots = positionSlots ? positionSlots : 1;
+    this->positionSlot = 0;
+    this->positionSequence = 0;
+    this->position = 0;
+}
+
+/**
+ * @brief Inicializa a fonte, recuperando a posição gravada
+ * 
+ * @param ledsCount Quantidade de leds da roleta
+ */
+void EepromDrawSource::begin(uint8_t ledsCount){
+    DrawSource::begin(ledsCount);
+    if(this->positionAddress == DRAW_SOURCE_NO_ADDRESS) return;
+
+    // A cópia mais recente é a última da cadeia de contadores consecutivos
+    uint8_t slot = 0;
+    uint8_t sequence = EEPROM.read(this->positionAddress);
+
+    while (slot + 1 < this->positionSlots)
+    {
+        uint8_t following = EEPROM.read(this->positionAddress + (slot + 1) * DRAW_SOURCE_SLOT_SIZE);
+        if(following != (uint8_t)(sequence + 1)) break;
+        slot++;
+        sequence = following;
+    }
+    this->positionSlot = slot;
+    this->positionSequence = sequence;
+
+    uint16_t slotAddress = this->positionAddress + slot * DRAW_SOURCE_SLOT_SIZE;
+    uint16_t position = EEPROM.read(slotAddress + 1) | (uint16_t)EEPROM.read(slotAddress + 2) << 8;
+    this->position = position < this->count ? position : 0;
+}
+
+/**
+ * @brief Obtém o próximo número da sequência
+ * 
+ * @return uint8_t Led sorteado, ou DRAW_SOURCE_EMPTY se a sequência está vazia
+ */
+uint8_t EepromDrawSource::next(){
+    if(this->count == 0) return DRAW_SOURCE_EMPTY;
+
+    uint8_t data = EEPROM.read(this->address + byteIndex(this->position, this->packed));
+    uint8_t led = unpack(data, this->position, this->packed);
+
+    this->position++;
+    if(this->position >= this->count) this->position = 0;
+    savePosition();
+    return led;
+}
+
+/**
+ * @brief Define o próximo número da sequência, gravando-o
+ * 
+ * @param position Índice na sequência (fora da sequência recomeça do início)
+ */
+void EepromDrawSource::setPosition(uint16_t position){
+    this->position = position < this->count ? position : 0;
+    savePosition();
+}
+
+/**
+ * @brief Obtém o próximo número da sequência
+ * 
+ * @return uint16_t Índice na sequência
+ */
+uint16_t EepromDrawSource::getPosition(){
+    return this->position;
+}
+
+/**
+ * Métodos privados
+ */
+
+/**
+ * @brief Grava a posição atual na próxima cópia do rodízio, se houver um endereço para ela
+ * @note O contador é gravado por último: se a energia cair no meio da gravação, a cópia anterior continua sendo a mais recente
+ * 
+ */
+void EepromDrawSource::savePosition(){
+    if(this->positionAddress == DRAW_SOURCE_NO_ADDRESS) return;
+
+    this->positionSlot = this->positionSlot + 1 < this->positionSlots ? this->positionSlot + 1 : 0;
+    this->positionSequence++;
+
+    uint16_t slotAddress = this->positionAddress + this->positionSlot * DRAW_SOURCE_SLOT_SIZE;
+    EEPROM.update(slotAddress + 1, this->position & 0xFF);
+    EEPROM.update(slotAddress + 2, this->position >> 8);
+    EEPROM.update(slotAddress, this->positionSequence);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file EepromDrawSource.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fonte de números gravados na EEPROM
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __EEPROMDRAWSOURCE__H__
+#define __EEPROMDRAWSOURCE__H__
+
+#include "DrawSource.h"
+
+#define DRAW_SOURCE_NO_ADDRESS 0xFFFF       //!< Endereço que desabilita a gravação da posição na EEPROM
+#define DRAW_SOURCE_POSITION_SLOTS 8        //!< Quantidade padrão de cópias da posição na EEPROM
+#define DRAW_SOURCE_SLOT_SIZE 3             //!< Bytes de uma cópia da posição: sequência (1) e posição (2)
+
+/**
+ * @brief Sequência predeterminada gravada na EEPROM, que pode ser trocada sem regravar o programa
+ * 
+ * Com um endereço para a posição, o índice do próximo número é gravado a
+ * cada sorteio, e a sequência continua de onde parou após desligar a
+ * roleta. Cada célula da EEPROM suporta cerca de 100.000 escritas: para
+ * distribuir o desgaste, a posição é gravada em rodízio entre
+ * positionSlots cópias de DRAW_SOURCE_SLOT_SIZE bytes, cada uma com um
+ * contador de 8 bits. A cópia mais recente é a última em que o contador
+ * da seguinte não é o seu sucessor. Ao fim da sequência ela recomeça.
+ */
+class EepromDrawSource : public DrawSource
+{
+private:
+    uint16_t address;                               //!< Endereço do primeiro byte da sequência
+    uint16_t count;                                 //!< Quantidade de números da sequência
+    bool packed;                                    //!< A sequência guarda dois números por byte
+    uint16_t positionAddress;                       //!< Endereço da primeira cópia da posição (DRAW_SOURCE_NO_ADDRESS = não grava)
+    uint8_t positionSlots;                          //!< Quantidade de cópias da posição
+    uint8_t positionSlot;                           //!< Cópia gravada por último
+    uint8_t positionSequence;                       //!< Contador da cópia gravada por último
+    uint16_t position;                              //!< Próximo número da sequência
+    void savePosition();
+public:
+    EepromDrawSource(uint16_t address, uint16_t count, bool packed = false, uint16_t positionAddress = DRAW_SOURCE_NO_ADDRESS, uint8_t positionSlots = DRAW_SOURCE_POSITION_SLOTS);
+    void begin(uint8_t ledsCount);
+    uint8_t next();
+    void setPosition(uint16_t position);
+    uint16_t getPosition();
+};
+
+#endif  //!__EEPROMDRAWSOURCE__H__
@@ -0,0 +1,60 @@
+/**
+ * @file ProgmemDrawSource.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fonte de números gravados em uma tabela na memória de programa
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "ProgmemDrawSource.h"
+
+/**
+ * @brief Constrói um novo objeto ProgmemDrawSource
+ * 
+ * @param table Tabela em PROGMEM
+ * @param count Quantidade de números da tabela (no formato compactado, o dobro da quantidade de bytes)
+ * @param packed Indica que a tabela guarda dois números por byte
+ */
+ProgmemDrawSource::ProgmemDrawSource(const uint8_t *table, uint16_t count, bool packed){
+    this->table = table;
+    this->count = count;
+    this->packed = packed;
+    this->position = 0;
+}
+
+/**
+ * @brief Obtém o próximo número da tabela
+ * 
+ * @return uint8_t Led sorteado, ou DRAW_SOURCE_EMPTY se a tabela está vazia
+ */
+uint8_t ProgmemDrawSource::next(){
+    if(this->count == 0) return DRAW_SOURCE_EMPTY;
+
+    uint8_t data = pgm_read_byte(this->table + byteIndex(this->position, this->packed));
+    uint8_t led = unpack(data, this->position, this->packed);
+
+    this->position++;
+    if(this->position >= this->count) this->position = 0;
+    return led;
+}
+
+/**
+ * @brief Define o próximo número da sequência
+ * 
+ * @param position Índice na tabela (fora da tabela recomeça do início)
+ */
+void ProgmemDrawSource::setPosition(uint16_t position){
+    this->position = position < this->count ? position : 0;
+}
+
+/**
+ * @brief Obtém o próximo número da sequência
+ * 
+ * @return uint16_t Índice na tabela
+ */
+uint16_t ProgmemDrawSource::getPosition(){
+    return this->position;
+}
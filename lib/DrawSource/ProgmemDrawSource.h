@@ -0,0 +1,35 @@
+/**
+ * @file ProgmemDrawSource.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fonte de números gravados em uma tabela na memória de programa
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __PROGMEMDRAWSOURCE__H__
+#define __PROGMEMDRAWSOURCE__H__
+
+#include "DrawSource.h"
+
+/**
+ * @brief Sequência predeterminada gravada em PROGMEM, sem ocupar RAM
+ * @note Ao fim da tabela a sequência recomeça. No formato compactado, escreva a tabela com DRAW_SOURCE_PACK()
+ */
+class ProgmemDrawSource : public DrawSource
+{
+private:
+    const uint8_t *table;                           //!< Tabela em PROGMEM
+    uint16_t count;                                 //!< Quantidade de números da tabela
+    bool packed;                                    //!< A tabela guarda dois números por byte
+    uint16_t position;                              //!< Próximo número da sequência
+public:
+    ProgmemDrawSource(const uint8_t *table, uint16_t count, bool packed = false);
+    uint8_t next();
+    void setPosition(uint16_t position);
+    uint16_t getPosition();
+};
+
+#endif  //!__PROGMEMDRAWSOURCE__H__
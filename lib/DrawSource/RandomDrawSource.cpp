@@ -0,0 +1,64 @@
+/**
+ * @file RandomDrawSource.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fonte de números aleatórios, sem viés entre os leds
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "RandomDrawSource.h"
+
+/**
+ * @brief Constrói um novo objeto RandomDrawSource
+ * 
+ */
+RandomDrawSource::RandomDrawSource(){
+    fast_random_seed(&this->random, 0);
+    this->seeded = false;
+}
+
+/**
+ * @brief Inicializa a fonte, obtendo uma semente do hardware se nenhuma foi definida
+ * 
+ * @param ledsCount Quantidade de leds da roleta
+ */
+void RandomDrawSource::begin(uint8_t ledsCount){
+    DrawSource::begin(ledsCount);
+    if(!this->seeded){
+        fast_random_seed(&this->random, hal_entropy());
+        this->seeded = true;
+    }
+}
+
+/**
+ * @brief Sorteia o próximo número
+ * 
+ * @return uint8_t Led sorteado (0 a ledsCount - 1), ou DRAW_SOURCE_EMPTY antes de begin()
+ */
+uint8_t RandomDrawSource::next(){
+    if(this->ledsCount == 0) return DRAW_SOURCE_EMPTY;
+    return fast_random_below(&this->random, this->ledsCount);
+}
+
+/**
+ * @brief Sorteia um número em um intervalo qualquer, com o mesmo gerador
+ * 
+ * @param bound Quantidade de valores possíveis (1 a 255)
+ * @return uint8_t Número entre 0 e bound - 1
+ */
+uint8_t RandomDrawSource::below(uint8_t bound){
+    return fast_random_below(&this->random, bound);
+}
+
+/**
+ * @brief Define a semente, para repetir uma sequência de sorteios
+ * 
+ * @param seed Semente
+ */
+void RandomDrawSource::setSeed(uint32_t seed){
+    fast_random_seed(&this->random, seed);
+    this->seeded = true;
+}
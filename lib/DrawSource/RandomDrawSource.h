@@ -0,0 +1,35 @@
+/**
+ * @file RandomDrawSource.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fonte de números aleatórios, sem viés entre os leds
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __RANDOMDRAWSOURCE__H__
+#define __RANDOMDRAWSOURCE__H__
+
+#include "DrawSource.h"
+#include "fast_random.h"
+
+/**
+ * @brief Sorteia cada número com o gerador xorshift da lib/fast_random
+ * @note Sem setSeed(), begin() obtém a semente do ruído do hardware (hal_entropy)
+ */
+class RandomDrawSource : public DrawSource
+{
+private:
+    fast_random_t random;                           //!< Gerador dos números
+    bool seeded;                                    //!< Indica que o gerador já recebeu uma semente
+public:
+    RandomDrawSource();
+    void begin(uint8_t ledsCount);
+    uint8_t next();
+    uint8_t below(uint8_t bound);
+    void setSeed(uint32_t seed);
+};
+
+#endif  //!__RANDOMDRAWSOURCE__H__
@@ -0,0 +1,182 @@
+/**
+ * @file RingDrawSource.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fonte de números guardados em um buffer circular na RAM
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "RingDrawSource.h"
+
+/**
+ * Métodos públicos
+ */
+
+/**
+ * @brief Constrói um novo objeto RingDrawSource
+ * 
+ * @param buffer Memória do buffer, mantida pela aplicação
+ * @param size Tamanho do buffer em bytes
+ */
+RingDrawSource::RingDrawSource(uint8_t *buffer, uint16_t size){
+    this->buffer = buffer;
+    this->size = size;
+    this->repeat = false;
+    clear();
+}
+
+/**
+ * @brief Inicializa a fonte
+ * @note Os números já guardados são mantidos. O formato compactado só muda quando o buffer estiver vazio
+ * 
+ * @param ledsCount Quantidade de leds da roleta
+ */
+void RingDrawSource::begin(uint8_t ledsCount){
+    DrawSource::begin(ledsCount);
+    if(this->count == 0) choosePacking();
+}
+
+/**
+ * @brief Obtém o próximo número
+ * 
+ * @return uint8_t Led sorteado, ou DRAW_SOURCE_EMPTY se o buffer está vazio
+ */
+uint8_t RingDrawSource::next(){
+    uint8_t led;
+
+    if(this->count == 0) return DRAW_SOURCE_EMPTY;
+
+    if(this->repeat){
+        led = peek(this->cursor);
+        this->cursor++;
+        if(this->cursor >= this->count) this->cursor = 0;
+        return led;
+    }
+
+    led = get(this->head);
+    this->head++;
+    if(this->head >= capacity()) this->head = 0;
+    this->count--;
+    if(this->count == 0) clear();
+    return led;
+}
+
+/**
+ * @brief Acrescenta um número ao fim da sequência
+ * 
+ * @param led Led a ser sorteado (0 a ledsCount - 1)
+ * @return true Se o número foi guardado
+ * @return false Se o buffer está cheio, ou o número não cabe no formato compactado em uso
+ */
+bool RingDrawSource::push(uint8_t led){
+    if(this->count >= capacity()) return false;
+    if(this->packed && led >= DRAW_SOURCE_PACKED_LEDS) return false;
+
+    uint16_t slot = this->head + this->count;
+    if(slot >= capacity()) slot -= capacity();
+    set(slot, led);
+    this->count++;
+    return true;
+}
+
+/**
+ * @brief Obtém quantos números ainda cabem no buffer
+ * 
+ * @return uint16_t Espaço livre
+ */
+uint16_t RingDrawSource::space(){
+    return capacity() - this->count;
+}
+
+/**
+ * @brief Descarta todos os números guardados
+ * 
+ */
+void RingDrawSource::clear(){
+    this->head = 0;
+    this->count = 0;
+    this->cursor = 0;
+    choosePacking();
+}
+
+/**
+ * @brief Define se a sequência é repetida ou consumida
+ * 
+ * @param repeat true para repetir a sequência guardada, false para consumir cada número (fila)
+ */
+void RingDrawSource::setRepeat(bool repeat){
+    this->repeat = repeat;
+    this->cursor = 0;
+}
+
+/**
+ * @brief Obtém a quantidade de números guardados
+ * 
+ * @return uint16_t Quantidade de números
+ */
+uint16_t RingDrawSource::available(){
+    return this->count;
+}
+
+/**
+ * @brief Obtém um número guardado, sem consumi-lo
+ * 
+ * @param index Posição a partir do número mais antigo
+ * @return uint8_t Led guardado, ou DRAW_SOURCE_EMPTY fora da sequência
+ */
+uint8_t RingDrawSource::peek(uint16_t index){
+    if(index >= this->count) return DRAW_SOURCE_EMPTY;
+
+    uint16_t slot = this->head + index;
+    if(slot >= capacity()) slot -= capacity();
+    return get(slot);
+}
+
+/**
+ * Métodos privados
+ */
+
+/**
+ * @brief Obtém a quantidade de números que cabem no buffer, no formato atual
+ * 
+ * @return uint16_t Capacidade
+ */
+uint16_t RingDrawSource::capacity(){
+    if(this->packed && this->size <= 0x7FFF) return this->size * 2;
+    return this->size;
+}
+
+/**
+ * @brief Lê o número de uma posição do buffer
+ * 
+ * @param slot Posição do número
+ * @return uint8_t Led guardado
+ */
+uint8_t RingDrawSource::get(uint16_t slot){
+    return unpack(this->buffer[byteIndex(slot, this->packed)], slot, this->packed);
+}
+
+/**
+ * @brief Grava o número de uma posição do buffer
+ * 
+ * @param slot Posição do número
+ * @param led Led a ser guardado
+ */
+void RingDrawSource::set(uint16_t slot, uint8_t led){
+    uint8_t *data = &this->buffer[byteIndex(slot, this->packed)];
+
+    if(!this->packed) *data = led;
+    else if(slot & 1) *data = (*data & 0x0F) | led << 4;
+    else *data = (*data & 0xF0) | led;
+}
+
+/**
+ * @brief Escolhe o formato do buffer vazio: compactado se a roleta tem até 16 leds
+ * 
+ */
+void RingDrawSource::choosePacking(){
+    this->packed = this->ledsCount > 0 && this->ledsCount <= DRAW_SOURCE_PACKED_LEDS && this->size <= 0x7FFF;
+}
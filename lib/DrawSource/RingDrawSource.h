@@ -0,0 +1,54 @@
+/**
+ * @file RingDrawSource.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fonte de números guardados em um buffer circular na RAM
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __RINGDRAWSOURCE__H__
+#define __RINGDRAWSOURCE__H__
+
+#include "DrawSource.h"
+
+/**
+ * @brief Buffer circular de sorteios, em um vetor fornecido pela aplicação
+ * 
+ * Na fila (padrão), cada número é consumido pelo sorteio que o utiliza, e
+ * novos números podem ser acrescentados com push() a qualquer momento (ex.:
+ * pelo comando "push" da serial). Com setRepeat(true) a sequência guardada é
+ * repetida, como a antiga lista de 24 números.
+ * 
+ * Quando o buffer está vazio e a roleta tem até 16 leds, os números passam a
+ * ser guardados dois por byte, dobrando a capacidade.
+ */
+class RingDrawSource : public DrawSource
+{
+private:
+    uint8_t *buffer;                                //!< Memória do buffer
+    uint16_t size;                                  //!< Tamanho do buffer em bytes
+    uint16_t head;                                  //!< Posição do número mais antigo
+    uint16_t count;                                 //!< Quantidade de números guardados
+    uint16_t cursor;                                //!< Próximo número da sequência repetida (relativo a head)
+    bool packed;                                    //!< Os números são guardados dois por byte
+    bool repeat;                                    //!< Repete a sequência em vez de consumir os números
+    uint16_t capacity();
+    uint8_t get(uint16_t slot);
+    void set(uint16_t slot, uint8_t led);
+    void choosePacking();
+public:
+    RingDrawSource(uint8_t *buffer, uint16_t size);
+    void begin(uint8_t ledsCount);
+    uint8_t next();
+    bool push(uint8_t led);
+    uint16_t space();
+    void clear();
+    void setRepeat(bool repeat);
+    uint16_t available();
+    uint8_t peek(uint16_t index);
+};
+
+#endif  //!__RINGDRAWSOURCE__H__
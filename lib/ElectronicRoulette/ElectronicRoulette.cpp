@@ -16,37 +16,55 @@
  * 
  */
 
-ElectronicRouletteState *stateToInterrupt;      //!< Estado da roleta eletrônica a ser manipulado pela interrupção
-bool filter = false;                            //!< Filtro para o botão que aciona os efeitos
+/**
+ * @brief Botão ligado a cada interrupção externa
+ */
+typedef struct
+{
+    ElectronicRoulette *roulette;       //!< Roleta dona do botão (NULL = interrupção livre)
+    bool start;                         //!< true para o botão que inicia o sorteio, false para o que prepara a roleta
+}roulette_button_route_t;
+
+HAL_THREAD_LOCAL roulette_button_route_t buttonRoutes[ROULETTE_INTERRUPT_COUNT];     //!< Roteamento das interrupções externas para as roletas
 
 /**
  * Interrupções
  */
 
 /**
- * @brief Função a ser chamada pela interrupção quando o botão que prepara a roleta for pressionado
+ * @brief Repassa a interrupção de um botão para a roleta dona do botão
  * 
+ * @param interruptNum Número da interrupção externa
  */
-void buttonReadyRoulettePressed(){
-    if(*stateToInterrupt == ElectronicRouletteState::ST_IDLE && !filter){
-        *stateToInterrupt = ElectronicRouletteState::ST_READY;
-    }
-    if(*stateToInterrupt == ElectronicRouletteState::ST_DRAWN){
-        *stateToInterrupt = ElectronicRouletteState::ST_IDLE;
-        filter = true;
-    }
+void rouletteButtonDispatch(uint8_t interruptNum){
+    roulette_button_route_t *route = &buttonRoutes[interruptNum];
+
+    if(route->roulette == NULL) return;
+    if(route->start) route->roulette->pressStart();
+    else route->roulette->pressReady();
 }
 
 /**
- * @brief Função a ser chamada pela interrupção quando o botão que inicia o sorteio for pressionado
+ * @brief Função a ser chamada pela interrupção externa 0
  * 
  */
-void buttonStartRoulettePressed(){
-    if(*stateToInterrupt == ElectronicRouletteState::ST_READY){
-        *stateToInterrupt = ElectronicRouletteState::ST_DRAWING;
-    }
+void rouletteButtonInterrupt0(){
+    rouletteButtonDispatch(0);
+}
+
+/**
+ * @brief Função a ser chamada pela interrupção externa 1
+ * 
+ */
+void rouletteButtonInterrupt1(){
+    rouletteButtonDispatch(1);
 }
 
+void (*const buttonInterrupts[ROULETTE_INTERRUPT_COUNT])(void) = {
+    rouletteButtonInterrupt0,
+    rouletteButtonInterrupt1,
+};
+
 /**
  * Métodos públicos
  */
@@ -55,25 +73,60 @@ void buttonStartRoulettePressed(){
  * @brief Constrói um novo objeto Electronic Roulette:: Electronic Roulette
  * 
  */
-ElectronicRoulette::ElectronicRoulette(){
+ElectronicRoulette::ElectronicRoulette() : ElectronicRoulette(roulette_config_t{
+    DEFAULT_LED_COUNT,
+    DEFAULT_INITIAL_PIN,
+    DEFAULT_INITIAL_SPEED,
+    roulette_speed_to_time(DEFAULT_INITIAL_SPEED),
+    DEFAULT_DECELERATION,
+    DEFAULT_STOP,
+    false
+}){
+}
+
+/**
+ * @brief Constrói um novo objeto Electronic Roulette:: Electronic Roulette a partir de uma configuração pronta
+ * @note Utilizado pelas variantes configuradas em tempo de compilação (StaticElectronicRoulette)
+ * 
+ * @param config Configuração inicial, com o tempo do passo já calculado
+ */
+ElectronicRoulette::ElectronicRoulette(roulette_config_t config) : listSource(listBuffer, DEFAULT_LIST_SIZE){
     this->state = ElectronicRouletteState::ST_IDLE;
-    this->ledsStatus = 0;
-    this->ledsCount = DEFAULT_LED_COUNT;
-    this->maxLedsStatus = pow(2, ledsCount - 1);
-    this->speed = DEFAULT_INITIAL_SPEED;
-    this->time = map(this->speed, 0, 100, DELAY_MAX, DELAY_MIN);
-    this->initialPin = DEFAULT_INITIAL_PIN;
+    bits_frame_clear(&this->ledsStatus);
+    this->ledsCount = config.ledsCount;
+    bits_frame_fill(&this->maxLedsStatus, this->ledsCount);
+    this->speed = config.speed;
+    this->time = config.time;
+    this->initialPin = config.initialPin;
     this->buttonReadyPin = DEFAULT_BT_RDY_PIN;
     this->buttonStartRoulettePin = DEFAULT_BT_START_PIN;
+    this->polledButtons = 0;
+    this->buttonLevels = 0;
+    this->buttonSeen = 0;
+    this->effectsFilter = false;
+    this->traceId = 0;
+    telemetry_channel_init(&this->telemetry, this->traceId, this->ledsCount, this->state);
+    button_queue_init(&this->buttonQueue);
     this->selectedLed = 0;
-    this->deceleration = DEFAULT_DECELERATION;
-    this->stopDeceleration = DEFAULT_STOP;
-    this->listIdx = 0;
+    this->deceleration = config.deceleration;
+    this->stopDeceleration = config.stopDeceleration;
+    this->fixedConfig = config.fixed;
+    this->started = false;
+    this->drawCount = 0;
     this->buzzerPin = DEFAULT_BUZ_PIN;
     this->buzzerTone = DEFAULT_BUZZER_TONE;
     this->buzzerToneDuration = DEFAULT_BUZZER_DURATION;
-
-    randomizeNumbersList();
+    this->ledOutput = &this->gpioOutput;
+    this->spinProfileValid = false;
+    this->spinStep = 0;
+    this->spinStopStep = SPIN_PROFILE_ENDLESS;
+    this->stopPlanner = true;
+    this->spinTime = 0;
+    this->easing = SPIN_EASING_LINEAR;
+    soft_timer_stop(&this->frameTimer);
+    this->listSource.setRepeat(true);
+    this->drawSource = &this->randomSource;
+    this->nextTargetValid = false;
 }
 
 /**
@@ -81,99 +134,245 @@ ElectronicRoulette::ElectronicRoulette(){
  * 
  */
 void ElectronicRoulette::begin(){
-    bits_effects_t effects;
-    uint8_t start = this->initialPin;
-    uint8_t end = this->initialPin + this->ledsCount;
-
-    effects.size = this->ledsCount;
-    effects.speed = map(this->speed, 0, 100, 0, 80);
-    bits_effects_init(effects);
-
-    for (size_t i = start; i < end; i++)
-    {
-        pinMode(i, OUTPUT);
-    }
-
-    pinMode(this->buttonReadyPin, INPUT_PULLUP);
-    pinMode(this->buttonStartRoulettePin, INPUT_PULLUP);
-
-    attachInterrupt(
-        digitalPinToInterrupt(this->buttonReadyPin),
-        buttonReadyRoulettePressed,
-        FALLING
-    );
-
-    attachInterrupt(
-        digitalPinToInterrupt(this->buttonStartRoulettePin),
-        buttonStartRoulettePressed,
-        FALLING
-    );
-
-    stateToInterrupt = &state;
+    this->randomSource.begin(this->ledsCount);
+    if(this->drawSource != &this->randomSource) this->drawSource->begin(this->ledsCount);
+    bits_effects_init(&this->bitsEffects, this->ledsCount, map(this->speed, 0, 100, 0, 80));
+
+    this->gpioOutput.setInitialPin(this->initialPin);
+    this->ledOutput->begin(this->ledsCount);
+    telemetry_channel_init(&this->telemetry, this->traceId, this->ledsCount, this->state);
+
+    this->polledButtons = 0;
+    attachButton(this->buttonReadyPin, false);
+    attachButton(this->buttonStartRoulettePin, true);
+    this->started = true;
 }
 
 /**
  * @brief Executa as rotinas da roleta eletrônica
+ * @note O loop pode dormir até o instante retornado (ex.: hal_sleep_until), desde que acorde com os botões
  * 
+ * @return uint32_t Instante (millis) em que a roleta precisa ser atualizada novamente
  */
-void ElectronicRoulette::task(){
+uint32_t ElectronicRoulette::task(){
+    uint32_t deadline = millis() + MAX_SLEEP_TIME;
+
+    processButtons();
+
     switch (state)
     {
     case ElectronicRouletteState::ST_IDLE:
         effects();
+        deadline = bits_effects_deadline(&this->bitsEffects);
         break;
     case ElectronicRouletteState::ST_READY:
         turnOff();
         break;
     case ElectronicRouletteState::ST_DRAWING:
         drawing();
+        deadline = soft_timer_deadline(&this->frameTimer);
         break;
     case ElectronicRouletteState::ST_DRAWN:
         flashSelectedLed();
+        deadline = soft_timer_deadline(&this->frameTimer);
         break;
     default:
         break;
     }
+
+    if(this->polledButtons && (int32_t)(deadline - (millis() + BUTTON_POLL_TIME)) > 0){
+        deadline = millis() + BUTTON_POLL_TIME;
+    }
+
+    telemetry_channel_flush(&this->telemetry);
+    return deadline;
+}
+
+/**
+ * @brief Registra o pressionamento do botão que prepara a roleta. Chamado pela interrupção do botão
+ * @note A fila de eventos tem um único produtor: fora da interrupção (ex.: comando da serial), utilizar commandReady().
+ * O estado da roleta só muda no próximo task(), que consome a fila de eventos
+ * 
+ */
+void ElectronicRoulette::pressReady(){
+    button_queue_push(&this->buttonQueue, BUTTON_READY, millis());
+    hal_wake();
+}
+
+/**
+ * @brief Registra o pressionamento do botão que inicia o sorteio. Chamado pela interrupção do botão
+ * @note A fila de eventos tem um único produtor: fora da interrupção (ex.: comando da serial), utilizar commandStart().
+ * O estado da roleta só muda no próximo task(), que consome a fila de eventos
+ * 
+ */
+void ElectronicRoulette::pressStart(){
+    button_queue_push(&this->buttonQueue, BUTTON_START, millis());
+    hal_wake();
+}
+
+/**
+ * @brief Aplica imediatamente o botão que prepara a roleta, sem passar pela fila da interrupção
+ * @note Para o contexto principal (ex.: comando da serial)
+ * 
+ */
+void ElectronicRoulette::commandReady(){
+    handleButton(BUTTON_READY, millis());
+}
+
+/**
+ * @brief Aplica imediatamente o botão que inicia o sorteio, sem passar pela fila da interrupção
+ * @note Para o contexto principal (ex.: comando da serial)
+ * 
+ */
+void ElectronicRoulette::commandStart(){
+    handleButton(BUTTON_START, millis());
+}
+
+/**
+ * @brief Verifica se há pressionamentos de botão aguardando o próximo task()
+ * @note Utilizado pelo RouletteController para executar a roleta imediatamente após um botão
+ * 
+ * @return true Se algum botão foi pressionado
+ */
+bool ElectronicRoulette::hasButtonEvents(){
+    return !button_queue_empty(&this->buttonQueue);
+}
+
+/**
+ * @brief Define os pinos dos botões. Deve ser chamada antes de begin()
+ * @note Botões em pinos com interrupção externa livre são atendidos pela interrupção; os demais são lidos a cada BUTTON_POLL_TIME
+ * 
+ * @param readyPin Pino do botão que prepara a roleta
+ * @param startPin Pino do botão que inicia o sorteio
+ */
+void ElectronicRoulette::setButtonPins(uint8_t readyPin, uint8_t startPin){
+    this->buttonReadyPin = readyPin;
+    this->buttonStartRoulettePin = startPin;
+}
+
+/**
+ * @brief Define a origem gravada nos registros do gravador de eventos (trace) e o canal da telemetria
+ * 
+ * @param id Identificação da roleta (0 a 15)
+ */
+void ElectronicRoulette::setTraceId(uint8_t id){
+    this->traceId = id & 0x0F;
+    this->telemetry.source = this->traceId;
+}
+
+/**
+ * @brief Define o pino do buzzer
+ * 
+ * @param buzzerPin Pino do buzzer
+ */
+void ElectronicRoulette::setBuzzerPin(uint8_t buzzerPin){
+    this->buzzerPin = buzzerPin;
 }
 
 /**
  * @brief Define o pino do primeiro led da cadeia de leds da roleta
+ * @note Ignorado quando a configuração é fixa (isConfigFixed)
  * 
  * @param initialPin Valor do pino
  */
 void ElectronicRoulette::setInitialLedsPins(uint8_t initialPin){
+    if(this->fixedConfig) return;
     this->initialPin = initialPin;
 }
 
 /**
  * @brief Define a quantidade de leds da roleta
+ * @note Ignorado quando a configuração é fixa (isConfigFixed). Após begin(), reconfigura a fonte de sorteios, a
+ * saída dos leds, os efeitos e a telemetria, sem refazer o restante da inicialização, e um giro em andamento é
+ * cancelado (a roleta volta para ST_READY)
  * 
- * @param ledCount A quantidade de leds
+ * @param ledCount A quantidade de leds (limitada a FRAME_MAX_BITS)
  */
 void ElectronicRoulette::setLedCount(uint8_t ledCount){
-    this->ledsCount = ledCount;
-    this->maxLedsStatus = pow(2, ledsCount) - 1;
+    if(this->fixedConfig) return;
+    this->ledsCount = ledCount > FRAME_MAX_BITS ? FRAME_MAX_BITS : ledCount;
+    bits_frame_fill(&this->maxLedsStatus, this->ledsCount);
+    if(this->selectedLed >= this->ledsCount) this->selectedLed = 0;
+    this->nextTargetValid = false;
+    this->spinProfileValid = false;
+    if(!this->started) return;
+
+    if(this->state == ElectronicRouletteState::ST_DRAWING){
+        soft_timer_stop(&this->frameTimer);
+        this->spinStep = 0;
+        setState(ElectronicRouletteState::ST_READY);
+    }
+    this->randomSource.begin(this->ledsCount);
+    if(this->drawSource != &this->randomSource) this->drawSource->begin(this->ledsCount);
+    bits_effects_init(&this->bitsEffects, this->ledsCount, map(this->speed, 0, 100, 0, 80));
+    this->ledOutput->begin(this->ledsCount);
+    telemetry_channel_set_leds(&this->telemetry, this->ledsCount);
+}
+
+/**
+ * @brief Define a saída utilizada para acionar os leds. Deve ser chamada antes de begin()
+ * 
+ * @param output Saída dos leds (ex.: ShiftRegisterLedOutput). NULL volta para a saída padrão pelos pinos
+ */
+void ElectronicRoulette::setLedOutput(LedOutput *output){
+    this->ledOutput = output ? output : &this->gpioOutput;
 }
 
 /**
  * @brief Define a velocidade da roleta
+ * @note Ignorado quando a configuração é fixa (isConfigFixed)
  * 
  * @param speed Percentual de velocidade de roleta (0 a 100)
  */
 void ElectronicRoulette::setSpeed(uint8_t speed){
+    if(this->fixedConfig) return;
     this->speed = speed;
+    this->time = roulette_speed_to_time(speed);
+    this->spinProfileValid = false;
 }
 
 /**
- * @brief Define a lista de números a serem sorteados
+ * @brief Define a lista de números a serem sorteados, repetida a cada 24 sorteios
+ * @note Atalho para uma RingDrawSource interna. Sequências maiores usam setDrawSource()
  * 
- * @param numbersList Lista de números de 24 posições
+ * @param numbersList Lista de números de 24 posições (1 a ledsCount). NULL volta para os números aleatórios
  */
 void ElectronicRoulette::setNumbersList(uint8_t numbersList[24]){
-    for (size_t i = 0; i < 24; i++)
+    this->nextTargetValid = false;
+    if(numbersList == NULL){
+        this->drawSource = &this->randomSource;
+        return;
+    }
+
+    this->listSource.clear();
+    for (size_t i = 0; i < DEFAULT_LIST_SIZE; i++)
     {
-        this->numbersList[i] = numbersList[i];
+        this->listSource.push(numbersList[i] - 1);
     }
+    this->drawSource = &this->listSource;
+}
+
+/**
+ * @brief Define a fonte dos números sorteados. Deve ser chamada antes de begin()
+ * @note O número é pedido à fonte no início de cada sorteio. Se ela não tiver um número válido
+ * (ex.: fila da serial vazia), o sorteio usa um número aleatório
+ * 
+ * @param source Fonte dos números (ex.: ProgmemDrawSource). NULL volta para os números aleatórios
+ */
+void ElectronicRoulette::setDrawSource(DrawSource *source){
+    this->drawSource = source ? source : &this->randomSource;
+    this->nextTargetValid = false;
+}
+
+/**
+ * @brief Define a semente dos números aleatórios, para repetir uma sequência de sorteios
+ * @note Sem semente, begin() obtém uma a partir do ruído do hardware (hal_entropy)
+ * 
+ * @param seed Semente
+ */
+void ElectronicRoulette::setSeed(uint32_t seed){
+    this->randomSource.setSeed(seed);
+    this->nextTargetValid = false;
 }
 
 /**
@@ -196,49 +395,371 @@ void ElectronicRoulette::setBuzzerDuration(uint8_t duration){
 
 /**
  * @brief Define a intensidade de desaceleração da roleta
+ * @note Ignorado quando a configuração é fixa (isConfigFixed)
  * 
  * @param deceleration Intensidade da desaceleração da roleta
  */
 void ElectronicRoulette::setDeceleration(uint8_t deceleration){
+    if(this->fixedConfig) return;
     this->deceleration = deceleration;
+    this->spinProfileValid = false;
 }
 
 /**
  * @brief Define por quanto tempo a roleta permanece em movimento
+ * @note Ignorado quando a configuração é fixa (isConfigFixed)
  * 
  * @param duration Duração do movimento da roleta
  */
 void ElectronicRoulette::setDuration(uint8_t duration){
+    if(this->fixedConfig) return;
     this->stopDeceleration = duration;
+    this->spinProfileValid = false;
+}
+
+/**
+ * @brief Habilita o planejamento do giro, que faz a roleta atingir a velocidade de parada exatamente sobre o led sorteado
+ * @note Desabilitado, a roleta desacelera até a velocidade de parada e segue girando até chegar ao led sorteado
+ * 
+ * @param enabled true para planejar o giro (padrão)
+ */
+void ElectronicRoulette::setStopPlanner(bool enabled){
+    this->stopPlanner = enabled;
+    this->spinProfileValid = false;
+}
+
+/**
+ * @brief Define a duração do giro planejado
+ * @note Valores acima de SPIN_PROFILE_MAX_SPIN_TIME são ignorados
+ * 
+ * @param spinTime Duração aproximada do giro em milissegundos (0 = definida pela desaceleração)
+ */
+void ElectronicRoulette::setSpinTime(uint16_t spinTime){
+    if(spinTime > SPIN_PROFILE_MAX_SPIN_TIME) return;
+    this->spinTime = spinTime;
+}
+
+/**
+ * @brief Define a curva de desaceleração do giro
+ * 
+ * @param easing Curva de desaceleração (SPIN_EASING_LINEAR mantém o comportamento original)
+ */
+void ElectronicRoulette::setEasing(spin_easing_t easing){
+    this->easing = easing < SPIN_EASING_COUNT ? easing : SPIN_EASING_LINEAR;
+    this->spinProfileValid = false;
+}
+
+/**
+ * @brief Calcula a duração do sorteio em andamento ou, fora do sorteio, do próximo sorteio
+ * @note Permite sincronizar o show com o momento em que a roleta para
+ * 
+ * @return uint32_t Duração do giro em milissegundos, até o led sorteado acender (SPIN_PROFILE_ENDLESS_TIME se a roleta não para)
+ */
+uint32_t ElectronicRoulette::getSpinDuration(){
+    const spin_profile_t *profile = getSpinProfile();
+
+    if(this->state == ElectronicRouletteState::ST_DRAWING && this->spinStep > 0){
+        return spin_profile_duration(profile, this->spinStopStep);
+    }
+
+    return spin_profile_duration(profile, planSpin());
+}
+
+/**
+ * @brief Obtém o estado da roleta
+ * 
+ * @return ElectronicRouletteState Estado atual
+ */
+ElectronicRouletteState ElectronicRoulette::getState(){
+    return this->state;
+}
+
+/**
+ * @brief Obtém a quantidade de leds da roleta
+ * 
+ * @return uint8_t Quantidade de leds
+ */
+uint8_t ElectronicRoulette::getLedCount(){
+    return this->ledsCount;
+}
+
+/**
+ * @brief Verifica se a configuração foi fixada na compilação (StaticElectronicRoulette)
+ * @note Nesse caso setLedCount, setInitialLedsPins, setSpeed, setDeceleration e setDuration não têm efeito,
+ * inclusive quando chamados por um ponteiro para ElectronicRoulette (ex.: SerialCommand)
+ * 
+ * @return true Se a configuração é fixa
+ */
+bool ElectronicRoulette::isConfigFixed(){
+    return this->fixedConfig;
+}
+
+/**
+ * @brief Obtém a velocidade da roleta
+ * 
+ * @return uint8_t Percentual de velocidade (0 a 100)
+ */
+uint8_t ElectronicRoulette::getSpeed(){
+    return this->speed;
+}
+
+/**
+ * @brief Obtém o tom do buzzer
+ * 
+ * @return uint16_t Tom do buzzer
+ */
+uint16_t ElectronicRoulette::getBuzzerTone(){
+    return this->buzzerTone;
+}
+
+/**
+ * @brief Obtém a duração do tom do buzzer
+ * 
+ * @return uint8_t Duração do tom
+ */
+uint8_t ElectronicRoulette::getBuzzerDuration(){
+    return this->buzzerToneDuration;
+}
+
+/**
+ * @brief Obtém a intensidade de desaceleração da roleta
+ * 
+ * @return uint8_t Intensidade da desaceleração
+ */
+uint8_t ElectronicRoulette::getDeceleration(){
+    return this->deceleration;
+}
+
+/**
+ * @brief Obtém o valor da desaceleração que para a roleta (ver setDuration)
+ * 
+ * @return uint16_t Duração do passo a partir da qual a roleta pode parar
+ */
+uint16_t ElectronicRoulette::getDuration(){
+    return this->stopDeceleration;
+}
+
+/**
+ * @brief Obtém a lista de números a serem sorteados
+ * 
+ * @param numbersList Destino da lista de 24 posições
+ * @return true Se há uma lista definida. Caso contrário os números são aleatórios e a lista não é alterada
+ */
+bool ElectronicRoulette::getNumbersList(uint8_t numbersList[24]){
+    if(this->drawSource != &this->listSource) return false;
+
+    for (size_t i = 0; i < DEFAULT_LIST_SIZE; i++)
+    {
+        numbersList[i] = this->listSource.peek(i) + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Obtém a fonte dos números sorteados
+ * 
+ * @return DrawSource* Fonte atual, ou NULL se os números são aleatórios
+ */
+DrawSource *ElectronicRoulette::getDrawSource(){
+    return this->drawSource == &this->randomSource ? NULL : this->drawSource;
+}
+
+/**
+ * @brief Indica se o planejamento do giro está habilitado
+ * 
+ * @return true Se o giro é planejado para parar sobre o led sorteado
+ */
+bool ElectronicRoulette::getStopPlanner(){
+    return this->stopPlanner;
+}
+
+/**
+ * @brief Obtém a duração desejada do giro planejado
+ * 
+ * @return uint16_t Duração em milissegundos (0 = definida pela desaceleração)
+ */
+uint16_t ElectronicRoulette::getSpinTime(){
+    return this->spinTime;
+}
+
+/**
+ * @brief Obtém a curva de desaceleração do giro
+ * 
+ * @return spin_easing_t Curva de desaceleração
+ */
+spin_easing_t ElectronicRoulette::getEasing(){
+    return this->easing;
 }
 
 /**
  * Métodos privados
  */
 
+/**
+ * @brief Altera o estado da roleta, gravando a transição no gravador de eventos e na telemetria
+ * @note Ao sair de ST_DRAWN o temporizador dos passos é parado, para que o próximo sorteio comece do instante
+ * do botão e não de um prazo antigo (após 2^31 ms parada, o prazo antigo pareceria estar no futuro)
+ * 
+ * @param state Novo estado
+ */
+void ElectronicRoulette::setState(ElectronicRouletteState state){
+    if(this->state == state) return;
+
+    if(this->state == ElectronicRouletteState::ST_DRAWN) soft_timer_stop(&this->frameTimer);
+    trace_record(TRACE_SOURCE(TRACE_STATE, this->traceId), state, this->state);
+    this->state = state;
+    telemetry_channel_state(&this->telemetry, state);
+}
+
+/**
+ * @brief Configura o pino de um botão, ligando-o a uma interrupção externa livre ou à leitura periódica
+ * 
+ * @param pin Pino do botão
+ * @param start true para o botão que inicia o sorteio
+ */
+void ElectronicRoulette::attachButton(uint8_t pin, bool start){
+    int interruptNum = digitalPinToInterrupt(pin);
+    uint8_t button = start ? BUTTON_START : BUTTON_READY;
+
+    pinMode(pin, INPUT_PULLUP);
+
+    if(interruptNum >= 0 && interruptNum < ROULETTE_INTERRUPT_COUNT &&
+        (buttonRoutes[interruptNum].roulette == NULL || buttonRoutes[interruptNum].roulette == this)){
+        buttonRoutes[interruptNum].roulette = this;
+        buttonRoutes[interruptNum].start = start;
+        attachInterrupt(interruptNum, buttonInterrupts[interruptNum], FALLING);
+        return;
+    }
+
+    this->polledButtons |= button;
+    if(digitalRead(pin)) this->buttonLevels |= button;
+    else this->buttonLevels &= ~button;
+}
+
+/**
+ * @brief Lê os botões sem interrupção, tratando a borda de descida como um pressionamento
+ * 
+ */
+void ElectronicRoulette::pollButtons(){
+    uint8_t levels = 0;
+
+    if((this->polledButtons & BUTTON_READY) && digitalRead(this->buttonReadyPin)) levels |= BUTTON_READY;
+    if((this->polledButtons & BUTTON_START) && digitalRead(this->buttonStartRoulettePin)) levels |= BUTTON_START;
+
+    uint8_t pressed = this->buttonLevels & ~levels;
+    this->buttonLevels = levels;
+
+    if(pressed & BUTTON_READY) handleButton(BUTTON_READY, millis());
+    if(pressed & BUTTON_START) handleButton(BUTTON_START, millis());
+}
+
+/**
+ * @brief Consome os eventos dos botões registrados pelas interrupções e lê os botões sem interrupção
+ * 
+ */
+void ElectronicRoulette::processButtons(){
+    button_event_t event;
+
+    while (button_queue_pop(&this->buttonQueue, &event))
+    {
+        handleButton(event.button, event.time);
+    }
+    if(this->polledButtons) pollButtons();
+}
+
+/**
+ * @brief Aplica o pressionamento de um botão ao estado da roleta
+ * 
+ * Um pressionamento a menos de BUTTON_DEBOUNCE_TIME do pressionamento
+ * anterior do mesmo botão é considerado trepidação e descartado. As
+ * transições são:
+ * - preparar: ST_IDLE -> ST_READY e ST_DRAWN -> ST_IDLE. Após ST_DRAWN -> ST_IDLE, o botão só volta
+ *   a preparar a roleta quando o efeito em exibição termina (bits_effects_all retorna true ao fim de
+ *   cada efeito da lista, não da lista inteira)
+ * - iniciar: ST_READY -> ST_DRAWING
+ * Nos demais estados o botão é ignorado.
+ * 
+ * @param button BUTTON_READY ou BUTTON_START
+ * @param time Instante (millis) do pressionamento
+ */
+void ElectronicRoulette::handleButton(uint8_t button, uint32_t time){
+    uint8_t index = button == BUTTON_START ? 1 : 0;
+    bool bounce = (this->buttonSeen & button) && (uint32_t)(time - this->buttonTime[index]) < BUTTON_DEBOUNCE_TIME;
+
+    this->buttonSeen |= button;
+    this->buttonTime[index] = time;
+    trace_record(TRACE_SOURCE(TRACE_BUTTON, this->traceId), button | (bounce ? TRACE_BUTTON_BOUNCE : 0), time);
+    if(bounce) return;
+
+    if(button == BUTTON_READY){
+        if(this->state == ElectronicRouletteState::ST_IDLE && !this->effectsFilter){
+            setState(ElectronicRouletteState::ST_READY);
+        }else if(this->state == ElectronicRouletteState::ST_DRAWN){
+            setState(ElectronicRouletteState::ST_IDLE);
+            this->effectsFilter = true;
+        }
+    }else if(button == BUTTON_START){
+        if(this->state == ElectronicRouletteState::ST_READY){
+            setState(ElectronicRouletteState::ST_DRAWING);
+        }
+    }
+}
+
+/**
+ * @brief Obtém o perfil do giro, recalculando-o se a configuração mudou
+ * 
+ * @return const spin_profile_t* Perfil do giro
+ */
+const spin_profile_t *ElectronicRoulette::getSpinProfile(){
+    if(!this->spinProfileValid){
+        spin_profile_build(&this->spinProfile, this->time, this->deceleration, this->stopDeceleration, this->ledsCount, this->easing);
+        this->spinProfileValid = true;
+    }
+    return &this->spinProfile;
+}
+
+/**
+ * @brief Calcula o último passo do giro que parte do led selecionado e termina no led do próximo sorteio
+ * 
+ * @return uint16_t Índice do último passo (SPIN_PROFILE_ENDLESS se a roleta não para)
+ */
+uint16_t ElectronicRoulette::planSpin(){
+    uint8_t target = getNextTarget();
+
+    getSpinProfile();
+    if(this->stopPlanner){
+        return spin_profile_plan(&this->spinProfile, this->spinTime, this->selectedLed, target);
+    }
+    return spin_profile_stop_step(&this->spinProfile, this->selectedLed, target);
+}
+
 /**
  * @brief Executa os efeitos da roleta
  * 
  */
 void ElectronicRoulette::effects(){
-    if(bits_effects_all()) filter = false;
-    this->ledsStatus = bits_effects_get_bits();
+    if(bits_effects_all(&this->bitsEffects)) this->effectsFilter = false;
+    this->ledsStatus = *bits_effects_get_bits(&this->bitsEffects);
     updateLeds();
 }
 
 /**
  * @brief Atualiza as saídas que acionam os leds
+ * @note Os efeitos operam em palavras inteiras: os bits além da quantidade de leds são apagados antes da escrita
  * 
  */
 void ElectronicRoulette::updateLeds(){
-    if(this->ledsStatus != 0 && this->state != ElectronicRouletteState::ST_IDLE){
+    bits_frame_and(&this->ledsStatus, &this->maxLedsStatus);
+    if(!bits_frame_is_zero(&this->ledsStatus) && this->state != ElectronicRouletteState::ST_IDLE){
         tone(this->buzzerPin, this->buzzerTone, this->buzzerToneDuration);
     }
-    for (size_t i = 0; i < ledsCount; i++)
-    {
-        uint8_t pin = this->initialPin + i;
-        bool status = bitRead(ledsStatus, i);
-        digitalWrite(pin, status);
+
+    if(this->ledOutput->write(&this->ledsStatus)){
+        for (uint8_t w = 0; w < FRAME_WORDS; w++)
+        {
+            trace_record(TRACE_SOURCE(TRACE_FRAME, this->traceId), w, this->ledsStatus.words[w]);
+        }
+        telemetry_channel_frame(&this->telemetry, &this->ledsStatus);
     }
 }
 
@@ -247,46 +768,63 @@ void ElectronicRoulette::updateLeds(){
  * 
  */
 void ElectronicRoulette::turnOff(){
-    ledsStatus = 0;
+    bits_frame_clear(&this->ledsStatus);
     updateLeds();
-    bits_effects_reset();
+    bits_effects_reset(&this->bitsEffects);
 }
 
 /**
- * @brief Atribui números aleatórios para serem sorteados na roleta
+ * @brief Obtém o led do próximo sorteio, pedindo-o à fonte na primeira chamada após o sorteio anterior
+ * @note Sem um número válido na fonte, usa um número aleatório. Se a fonte estiver vazia fora de um sorteio
+ * (ex.: na estimativa de getSpinDuration), o número aleatório não é guardado, e a fonte é consultada de novo
  * 
+ * @return uint8_t Led sorteado (0 a ledsCount - 1)
  */
-void ElectronicRoulette::randomizeNumbersList(){
-    for (size_t i = 0; i < 24; i++)
-    {
-        this->numbersList[i] = random(1, this->ledsCount);
+uint8_t ElectronicRoulette::getNextTarget(){
+    if(this->nextTargetValid) return this->nextTarget;
+
+    uint8_t target = this->drawSource->next();
+
+    if(target >= this->ledsCount){
+        bool empty = target == DRAW_SOURCE_EMPTY;
+        target = this->randomSource.below(this->ledsCount);
+        if(empty && this->state != ElectronicRouletteState::ST_DRAWING) return target;
     }
+    this->nextTarget = target;
+    this->nextTargetValid = true;
+    return this->nextTarget;
 }
 
 /**
- * @brief Realiza o sorteio
+ * @brief Realiza o sorteio, avançando um led a cada vez que o prazo do passo anterior expira
  * 
  */
 void ElectronicRoulette::drawing(){
-    static uint16_t totalDeceleration = 0;
-    uint16_t totalTime = this->time + totalDeceleration;
+    if(!soft_timer_expired(&this->frameTimer)) return;
 
-    this->ledsStatus = 0;
-    bitSet(this->ledsStatus, this->selectedLed);
-    updateLeds();    
-    delay(totalTime);
+    const spin_profile_t *profile = getSpinProfile();
 
-    if(totalTime >= this->stopDeceleration && this->selectedLed == (this->numbersList[listIdx] - 1)){
-        this->state = ElectronicRouletteState::ST_DRAWN;
-        this->listIdx++;
-        totalDeceleration = 0;
+    if(this->spinStep == 0){
+        this->spinStopStep = planSpin();
+        trace_record(TRACE_SOURCE(TRACE_DRAW_START, this->traceId), getNextTarget(), spin_profile_duration(profile, this->spinStopStep));
+    }
 
-        if(this->listIdx >= DEFAULT_LIST_SIZE) this->listIdx = 0;
+    bits_frame_clear(&this->ledsStatus);
+    bits_frame_set(&this->ledsStatus, this->selectedLed);
+    updateLeds();    
+    soft_timer_next(&this->frameTimer, spin_profile_step_time(profile, this->spinStep));
+
+    if(this->spinStep == this->spinStopStep){
+        setState(ElectronicRouletteState::ST_DRAWN);
+        trace_record(TRACE_SOURCE(TRACE_DRAW_RESULT, this->traceId), this->selectedLed, this->drawCount);
+        this->drawCount++;
+        this->spinStep = 0;
+        this->nextTargetValid = false;
         return;
     }
 
     this->selectedLed++;
-    totalDeceleration += this->deceleration;
+    if(this->spinStep < SPIN_PROFILE_ENDLESS - 1) this->spinStep++;
     if (this->selectedLed >= this->ledsCount)
     {
         this->selectedLed = 0;
@@ -298,14 +836,16 @@ void ElectronicRoulette::drawing(){
  * 
  */
 void ElectronicRoulette::flashSelectedLed(){
-    if(this->ledsStatus == 0){
-        bitSet(this->ledsStatus, selectedLed);
+    if(!soft_timer_expired(&this->frameTimer)) return;
+
+    if(bits_frame_is_zero(&this->ledsStatus)){
+        bits_frame_set(&this->ledsStatus, selectedLed);
         updateLeds();
     }else{
-        this->ledsStatus = 0;
+        bits_frame_clear(&this->ledsStatus);
         updateLeds();
     }
-    delay(150);
+    soft_timer_next(&this->frameTimer, DEFAULT_FLASH_TIME);
 }
 
 /**
@@ -326,7 +866,7 @@ void ElectronicRoulette::test(){
         printLedsStatus();
     }
 
-    state = ElectronicRouletteState::ST_READY;
+    setState(ElectronicRouletteState::ST_READY);
     Serial.println("Roleta preparada.");
     delay(1000);
 
@@ -335,7 +875,7 @@ void ElectronicRoulette::test(){
         printLedsStatus();
     }    
 
-    state = ElectronicRouletteState::ST_DRAWING;
+    setState(ElectronicRouletteState::ST_DRAWING);
     Serial.println("Sorteio iniciado.");
     delay(1000);
 
@@ -347,15 +887,20 @@ void ElectronicRoulette::test(){
 
 /**
  * @brief Imprime o estado dos leds
+ * @note Bloqueia quando o buffer da serial enche. Para acompanhar a roleta em funcionamento, utilize a telemetria (telemetry_flush)
  * 
  */
 void ElectronicRoulette::printLedsStatus(){
-    Serial.print(ledsStatus);
+    for (uint8_t w = FRAME_WORDS; w > 0; w--)
+    {
+        Serial.print(ledsStatus.words[w - 1]);
+        if(w > 1) Serial.print(':');
+    }
     Serial.print('\t');
 
     for (size_t i = 0; i < ledsCount; i++)
     {
-        Serial.print(bitRead(ledsStatus, i));
+        Serial.print(bits_frame_get(&ledsStatus, i) ? '1' : '0');
     }
     Serial.println();
 }
\ No newline at end of file
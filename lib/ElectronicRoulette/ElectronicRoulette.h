@@ -12,8 +12,16 @@
 #ifndef __ELECTRONICROULETTE__H__
 #define __ELECTRONICROULETTE__H__
 
-#include <Arduino.h>
+#include "hal.h"
 #include "bits_effects.h"
+#include "soft_timer.h"
+#include "spin_profile.h"
+#include "button_queue.h"
+#include "RandomDrawSource.h"
+#include "RingDrawSource.h"
+#include "trace.h"
+#include "telemetry.h"
+#include "GpioLedOutput.h"
 
 #define DELAY_MIN 0                     //!< Delay máximo para ajuste da velocidade máxima da roleta
 #define DELAY_MAX 250                   //!< Delay mínimo para ajuste da velocidade mínima da roleta
@@ -28,6 +36,13 @@
 #define DEFAULT_LIST_SIZE 24            //!< Valor padrão para o tamanho da lista dos numeros sorteados
 #define DEFAULT_BUZZER_DURATION 20      //!< Valor padrão para a duração do som do buzzer
 #define DEFAULT_BUZZER_TONE 500         //!< Tom padrão do buzzer
+#define DEFAULT_FLASH_TIME 150          //!< Intervalo do pisca do led sorteado
+#define MAX_SLEEP_TIME 1000             //!< Tempo máximo sem atualização quando a roleta aguarda apenas os botões
+#define BUTTON_DEBOUNCE_TIME 50         //!< Intervalo mínimo entre dois pressionamentos do mesmo botão (menores são trepidação)
+#define BUTTON_POLL_TIME 10             //!< Intervalo de leitura dos botões ligados a pinos sem interrupção externa livre
+#define ROULETTE_INTERRUPT_COUNT 2      //!< Interrupções externas disponíveis para os botões (INT0 e INT1 no Arduino Uno)
+#define BUTTON_READY 0x01               //!< Máscara do botão que prepara a roleta
+#define BUTTON_START 0x02               //!< Máscara do botão que inicia o sorteio
 
 /**
  * @brief Estados da roleta eletrônica
@@ -40,47 +55,135 @@ enum ElectronicRouletteState
     ST_DRAWN          //!< Sorteio realizado. Aguardando comando.
 };
 
+/**
+ * @brief Configuração inicial da roleta eletrônica
+ */
+typedef struct
+{
+    uint8_t ledsCount;                              //!< Quantidade de leds da roleta
+    uint8_t initialPin;                             //!< Pino inicial da cadeia de leds
+    uint8_t speed;                                  //!< Velocidade da roleta (0 a 100)
+    uint16_t time;                                  //!< Tempo do passo na velocidade inicial (ver roulette_speed_to_time)
+    uint8_t deceleration;                           //!< Intensidade da desaceleração da roleta
+    uint16_t stopDeceleration;                      //!< Valor utilizado para parar a roleta
+    bool fixed;                                     //!< Configuração fixada na compilação: os setters destes campos ignoram novos valores
+}roulette_config_t;
+
+/**
+ * @brief Converte a velocidade da roleta no tempo de cada passo, entre DELAY_MAX e DELAY_MIN
+ * @note Mesmo resultado de map(speed, 0, 100, DELAY_MAX, DELAY_MIN), mas avaliado em tempo de compilação quando possível
+ * 
+ * @param speed Velocidade da roleta (0 a 100)
+ * @return constexpr uint16_t Tempo do passo em milissegundos
+ */
+constexpr uint16_t roulette_speed_to_time(uint8_t speed){
+    return DELAY_MAX + (int32_t)speed * (DELAY_MIN - DELAY_MAX) / 100;
+}
+
 /**
  * @brief Classe principal da roleta eletrônica
  */
 class ElectronicRoulette
 {
 private:
-    ElectronicRouletteState state;                  //!< Estado da roleta eletrônica
-    uint32_t ledsStatus;                            //!< Variável de 32 bits para armazenar os estados dos leds
-    uint32_t maxLedsStatus;                         //!< Variável de 32 bits para armazenar o estado máximo dos leds
-    uint8_t ledsCount;                              //!< Quantidade de leds da roleta eletrônica (0 - 32)
+    ElectronicRouletteState state;                  //!< Estado da roleta eletrônica (alterado somente no loop principal)
+    bits_frame_t ledsStatus;                        //!< Quadro para armazenar os estados dos leds
+    bits_frame_t maxLedsStatus;                     //!< Quadro com todos os leds da roleta acesos (máscara de ledsStatus)
+    uint8_t ledsCount;                              //!< Quantidade de leds da roleta eletrônica (0 - FRAME_MAX_BITS)
     uint8_t speed;                                  //!< Velocidade da roleta eletrônica
     uint16_t time;                                  //!< Tempo calculado com base na velocidade da roleta, e as constantes de delay
     uint8_t initialPin;                             //!< Pino inicial da cadeia de leds
     uint8_t buttonReadyPin;                         //!< Pino do botão que prepara a roleta (desligando o efeito dos leds)
     uint8_t buttonStartRoulettePin;                 //!< Pino do botão que inicia o sorteio da roleta
+    uint8_t polledButtons;                          //!< Botões lidos periodicamente, por não terem interrupção externa livre (BUTTON_READY, BUTTON_START)
+    uint8_t buttonLevels;                           //!< Último nível lido dos botões lidos periodicamente
+    button_queue_t buttonQueue;                     //!< Pressionamentos registrados pelas interrupções, consumidos por task()
+    uint8_t buttonSeen;                             //!< Botões que já foram pressionados ao menos uma vez
+    uint32_t buttonTime[2];                         //!< Instante do último pressionamento de cada botão (preparar, iniciar)
+    bool effectsFilter;                             //!< Ignora o botão de preparar após ST_DRAWN -> ST_IDLE, até o fim do efeito em exibição
+    uint8_t traceId;                                //!< Origem gravada nos registros do gravador de eventos
+    telemetry_channel_t telemetry;                  //!< Canal da roleta na telemetria binária
     uint8_t selectedLed;                            //!< Led selecionado atualmente na roleta
     uint8_t deceleration;                           //!< Intensidade da desaceleração da roleta
     uint16_t stopDeceleration;                      //!< Valor utilizado para parar a roleta.
-    uint8_t listIdx;                                //!< Índice da lista numbersList
+    bool fixedConfig;                               //!< Leds, pino inicial, velocidade, desaceleração e parada fixados na compilação (StaticElectronicRoulette)
+    bool started;                                   //!< begin() já foi chamada: mudanças de configuração são aplicadas imediatamente
+    uint16_t drawCount;                             //!< Quantidade de sorteios realizados
     uint8_t buzzerPin;                              //!< Pino do buzzer para efeito sonoro
     uint16_t buzzerTone;                            //!< Valor do tone do buzzer
     uint8_t buzzerToneDuration;                     //!< Duração do tone do buzzer
-    uint8_t numbersList[DEFAULT_LIST_SIZE];         //!< Sequência de números que serão sorteados
+    uint8_t listBuffer[DEFAULT_LIST_SIZE];          //!< Memória de listSource
+    RingDrawSource listSource;                      //!< Lista definida por setNumbersList(), repetida a cada DEFAULT_LIST_SIZE sorteios
+    RandomDrawSource randomSource;                  //!< Fonte padrão, e reserva quando a fonte atual não tem um número válido
+    DrawSource *drawSource;                         //!< Fonte dos números sorteados
+    uint8_t nextTarget;                             //!< Led do próximo sorteio (0 a ledsCount - 1)
+    bool nextTargetValid;                           //!< Indica que nextTarget já foi escolhido
+    bits_effects_t bitsEffects;                     //!< Motor dos efeitos exibidos enquanto a roleta aguarda
+    soft_timer_t frameTimer;                        //!< Temporizador dos passos do sorteio e do pisca do led sorteado
+    spin_profile_t spinProfile;                     //!< Duração de cada passo do sorteio, calculada a partir da configuração
+    bool spinProfileValid;                          //!< Indica se spinProfile corresponde à configuração atual
+    uint16_t spinStep;                              //!< Passo atual do sorteio (0 = sorteio não iniciado)
+    uint16_t spinStopStep;                          //!< Passo em que o sorteio atual termina
+    bool stopPlanner;                               //!< Planeja o giro para parar sobre o led sorteado, sem a volta extra
+    uint16_t spinTime;                              //!< Duração desejada do giro planejado (0 = definida pela desaceleração)
+    spin_easing_t easing;                           //!< Curva de desaceleração do giro
+    GpioLedOutput gpioOutput;                       //!< Saída padrão, pelos pinos a partir de initialPin
+    LedOutput *ledOutput;                           //!< Saída utilizada para acionar os leds
+    void setState(ElectronicRouletteState state);
+    void attachButton(uint8_t pin, bool start);
+    void pollButtons();
+    void processButtons();
+    void handleButton(uint8_t button, uint32_t time);
     void effects();
     void updateLeds();
     void turnOff();
-    void randomizeNumbersList();
+    uint8_t getNextTarget();
+    const spin_profile_t *getSpinProfile();
+    uint16_t planSpin();
     void drawing();
     void flashSelectedLed();
+protected:
+    ElectronicRoulette(roulette_config_t config);
 public:
     ElectronicRoulette();
     void begin();
-    void task();
+    uint32_t task();
+    void pressReady();
+    void pressStart();
+    void commandReady();
+    void commandStart();
+    bool hasButtonEvents();
     void setInitialLedsPins(uint8_t initialPin);
+    void setButtonPins(uint8_t readyPin, uint8_t startPin);
+    void setBuzzerPin(uint8_t buzzerPin);
+    void setTraceId(uint8_t id);
     void setLedCount(uint8_t ledCount);
+    void setLedOutput(LedOutput *output);
     void setSpeed(uint8_t speed);
     void setBuzzerTone(uint16_t tone);
     void setBuzzerDuration(uint8_t duration);
     void setDeceleration(uint8_t deceleration);
     void setDuration(uint8_t duration);
     void setNumbersList(uint8_t numbersList[24]);
+    void setDrawSource(DrawSource *source);
+    void setSeed(uint32_t seed);
+    void setStopPlanner(bool enabled);
+    void setSpinTime(uint16_t spinTime);
+    void setEasing(spin_easing_t easing);
+    uint32_t getSpinDuration();
+    ElectronicRouletteState getState();
+    uint8_t getLedCount();
+    bool isConfigFixed();
+    uint8_t getSpeed();
+    uint16_t getBuzzerTone();
+    uint8_t getBuzzerDuration();
+    uint8_t getDeceleration();
+    uint16_t getDuration();
+    bool getNumbersList(uint8_t numbersList[24]);
+    DrawSource *getDrawSource();
+    bool getStopPlanner();
+    uint16_t getSpinTime();
+    spin_easing_t getEasing();
     void test();
     void printLedsStatus();
 };
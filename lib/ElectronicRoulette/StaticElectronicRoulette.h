@@ -0,0 +1,67 @@
+/**
+ * @file StaticElectronicRoulette.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Variante da roleta eletrônica configurada em tempo de compilação
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __STATICELECTRONICROULETTE__H__
+#define __STATICELECTRONICROULETTE__H__
+
+#include "ElectronicRoulette.h"
+#include "StaticGpioLedOutput.h"
+
+/**
+ * @brief Roleta eletrônica com leds, pinos, velocidade e desaceleração fixos
+ * 
+ * O tempo do passo é calculado com constexpr, e no Arduino Uno as portas,
+ * máscaras e deslocamentos dos leds são constantes, de modo que cada quadro
+ * vira algumas poucas instruções de escrita nas portas. Os setters dessas
+ * configurações ficam indisponíveis na classe e, quando chamados por um
+ * ponteiro para ElectronicRoulette (ex.: pela SerialCommand), não têm efeito
+ * (isConfigFixed). Para configurar em tempo de execução, utilize
+ * ElectronicRoulette.
+ * 
+ * @tparam LedCount Quantidade de leds da roleta
+ * @tparam InitialPin Pino do primeiro led da cadeia
+ * @tparam Speed Velocidade da roleta (0 a 100)
+ * @tparam Deceleration Intensidade da desaceleração da roleta
+ * @tparam Duration Valor utilizado para parar a roleta
+ */
+template<uint8_t LedCount, uint8_t InitialPin = DEFAULT_INITIAL_PIN, uint8_t Speed = DEFAULT_INITIAL_SPEED,
+    uint8_t Deceleration = DEFAULT_DECELERATION, uint16_t Duration = DEFAULT_STOP>
+class StaticElectronicRoulette : public ElectronicRoulette
+{
+    static_assert(LedCount > 0 && LedCount <= FRAME_MAX_BITS, "LedCount deve estar entre 1 e FRAME_MAX_BITS");
+    static_assert(Speed <= 100, "Speed deve estar entre 0 e 100");
+private:
+#ifdef HAL_UNO_PIN_MAP
+    StaticGpioLedOutput<InitialPin, LedCount> output;  //!< Saída com o agrupamento por porta calculado na compilação
+#endif
+    using ElectronicRoulette::setInitialLedsPins;
+    using ElectronicRoulette::setLedCount;
+    using ElectronicRoulette::setSpeed;
+    using ElectronicRoulette::setDeceleration;
+    using ElectronicRoulette::setDuration;
+public:
+    static constexpr uint16_t stepTime = roulette_speed_to_time(Speed);     //!< Tempo do passo na velocidade inicial
+
+    /**
+     * @brief Constrói um novo objeto StaticElectronicRoulette
+     * 
+     */
+    StaticElectronicRoulette() : ElectronicRoulette(roulette_config_t{LedCount, InitialPin, Speed, stepTime, Deceleration, Duration, true}){
+#ifdef HAL_UNO_PIN_MAP
+        setLedOutput(&this->output);
+#endif
+    }
+};
+
+template<uint8_t LedCount, uint8_t InitialPin, uint8_t Speed, uint8_t Deceleration, uint16_t Duration>
+constexpr uint16_t StaticElectronicRoulette<LedCount, InitialPin, Speed, Deceleration, Duration>::stepTime;
+
+#endif  //!__STATICELECTRONICROULETTE__H__
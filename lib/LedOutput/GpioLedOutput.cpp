@@ -0,0 +1,171 @@
+/**
+ * @file GpioLedOutput.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Saída da cadeia de leds ligada diretamente a pinos consecutivos
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "GpioLedOutput.h"
+
+/**
+ * @brief Constrói um novo objeto GpioLedOutput
+ * 
+ * @param initialPin Pino do primeiro led da cadeia
+ */
+GpioLedOutput::GpioLedOutput(uint8_t initialPin){
+    this->initialPin = initialPin;
+    this->ledPortsCount = 0;
+    this->ledRunsCount = 0;
+}
+
+/**
+ * @brief Define o pino do primeiro led da cadeia. Tem efeito no próximo begin()
+ * 
+ * @param initialPin Valor do pino
+ */
+void GpioLedOutput::setInitialPin(uint8_t initialPin){
+    this->initialPin = initialPin;
+}
+
+/**
+ * @brief Configura os pinos como saída e agrupa os pinos por porta
+ * 
+ * @param ledsCount Quantidade de leds da cadeia
+ */
+void GpioLedOutput::begin(uint8_t ledsCount){
+    LedOutput::begin(ledsCount);
+
+    for (uint8_t i = 0; i < ledsCount; i++)
+    {
+        pinMode(this->initialPin + i, OUTPUT);
+    }
+
+    if(!resolvePorts()){
+        this->ledPortsCount = 0;
+        this->ledRunsCount = 0;
+    }
+}
+
+/**
+ * @brief Escreve os leds alterados
+ * 
+ * @param frame Estado dos leds
+ * @param changed Leds que mudaram desde o último quadro
+ */
+void GpioLedOutput::writeFrame(const bits_frame_t *frame, const bits_frame_t *changed){
+    if(this->ledPortsCount == 0){
+        writePins(frame, changed);
+        return;
+    }
+
+    writePorts(frame, changed);
+
+#ifdef HAL_VERIFY_LED_PORTS
+    uint8_t ports[HAL_PORT_COUNT];
+    hal_ports_save(ports);
+    writePins(frame, &this->ledsMask);
+    if(!hal_ports_equal(ports)){
+        fprintf(stderr, "GpioLedOutput: escrita por porta difere da escrita pino a pino (leds %lu)\n", (unsigned long)frame->words[0]);
+        abort();
+    }
+#endif
+}
+
+/**
+ * @brief Agrupa os pinos da cadeia de leds por porta, para que uma porta inteira seja escrita de uma vez
+ * 
+ * @return true Se todos os pinos foram agrupados
+ * @return false Se algum pino não tem porta conhecida ou os limites MAX_LED_PORTS/MAX_LED_RUNS foram excedidos
+ */
+bool GpioLedOutput::resolvePorts(){
+    this->ledPortsCount = 0;
+    this->ledRunsCount = 0;
+
+#ifdef HAL_HAS_PORTS
+    for (uint8_t i = 0; i < this->ledsCount; i++)
+    {
+        uint8_t pin = this->initialPin + i;
+        uint8_t portId = digitalPinToPort(pin);
+        uint8_t mask = digitalPinToBitMask(pin);
+        if(portId == NOT_A_PIN || mask == 0) return false;
+
+        volatile uint8_t *out = portOutputRegister(portId);
+        uint8_t port = 0;
+        while (port < this->ledPortsCount && this->ledPorts[port].out != out) port++;
+        if(port == this->ledPortsCount){
+            if(port >= MAX_LED_PORTS) return false;
+            this->ledPorts[port].out = out;
+            this->ledPorts[port].mask = 0;
+            this->ledPortsCount++;
+        }
+        this->ledPorts[port].mask |= mask;
+
+        if(this->ledRunsCount > 0){
+            led_run_t *last = &this->ledRuns[this->ledRunsCount - 1];
+            uint8_t nextBit = last->firstBit + i - last->firstLed;
+            if(last->port == port && nextBit < 8 && mask == (1 << nextBit)){
+                last->mask |= mask;
+                continue;
+            }
+        }
+
+        if(this->ledRunsCount >= MAX_LED_RUNS) return false;
+        led_run_t *run = &this->ledRuns[this->ledRunsCount++];
+        run->port = port;
+        run->firstLed = i;
+        run->firstBit = 0;
+        while (!(mask & (1 << run->firstBit))) run->firstBit++;
+        run->mask = mask;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Escreve as portas com leds alterados, com uma leitura-modificação-escrita por porta
+ * 
+ * @param frame Estado dos leds
+ * @param changed Leds que mudaram desde o último quadro
+ */
+void GpioLedOutput::writePorts(const bits_frame_t *frame, const bits_frame_t *changed){
+#ifdef HAL_HAS_PORTS
+    uint8_t values[MAX_LED_PORTS] = {0};
+    uint8_t dirty[MAX_LED_PORTS] = {0};
+
+    for (uint8_t i = 0; i < this->ledRunsCount; i++)
+    {
+        led_run_t *run = &this->ledRuns[i];
+        values[run->port] |= (uint8_t)(bits_frame_get_byte(frame, run->firstLed) << run->firstBit) & run->mask;
+        dirty[run->port] |= (uint8_t)(bits_frame_get_byte(changed, run->firstLed) << run->firstBit) & run->mask;
+    }
+
+    for (uint8_t i = 0; i < this->ledPortsCount; i++)
+    {
+        if(!dirty[i]) continue;
+        hal_port_write(this->ledPorts[i].out, this->ledPorts[i].mask, values[i]);
+    }
+#else
+    (void)frame;
+    (void)changed;
+#endif
+}
+
+/**
+ * @brief Escreve os leds alterados pino a pino
+ * 
+ * @param frame Estado dos leds
+ * @param changed Leds que mudaram desde o último quadro
+ */
+void GpioLedOutput::writePins(const bits_frame_t *frame, const bits_frame_t *changed){
+    for (uint8_t i = 0; i < this->ledsCount; i++)
+    {
+        if(!bits_frame_get(changed, i)) continue;
+        digitalWrite(this->initialPin + i, bits_frame_get(frame, i));
+    }
+}
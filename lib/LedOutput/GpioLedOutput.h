@@ -0,0 +1,66 @@
+/**
+ * @file GpioLedOutput.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Saída da cadeia de leds ligada diretamente a pinos consecutivos
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __GPIOLEDOUTPUT__H__
+#define __GPIOLEDOUTPUT__H__
+
+#include "LedOutput.h"
+
+#define MAX_LED_PORTS 4                 //!< Quantidade máxima de portas de 8 bits ocupadas pela cadeia de leds
+#define MAX_LED_RUNS 8                  //!< Quantidade máxima de trechos de pinos consecutivos na cadeia de leds
+
+/**
+ * @brief Porta de 8 bits ocupada pela cadeia de leds
+ */
+typedef struct
+{
+    volatile uint8_t *out;                          //!< Registrador PORTx
+    uint8_t mask;                                   //!< Bits da porta ocupados pelos leds
+}led_port_t;
+
+/**
+ * @brief Trecho de leds consecutivos ligados a bits consecutivos de uma mesma porta
+ */
+typedef struct
+{
+    uint8_t port;                                   //!< Índice da porta em ledPorts
+    uint8_t firstLed;                               //!< Primeiro led do trecho
+    uint8_t firstBit;                               //!< Bit da porta ligado ao primeiro led
+    uint8_t mask;                                   //!< Bits da porta ocupados pelo trecho
+}led_run_t;
+
+/**
+ * @brief Saída por pinos digitais, a partir de um pino inicial
+ * 
+ * Em begin() os pinos são agrupados por porta, e cada quadro é escrito com
+ * uma leitura-modificação-escrita por porta alterada. Pinos sem porta
+ * conhecida são escritos um a um com digitalWrite.
+ */
+class GpioLedOutput : public LedOutput
+{
+private:
+    uint8_t initialPin;                             //!< Pino do primeiro led da cadeia
+    led_port_t ledPorts[MAX_LED_PORTS];             //!< Portas ocupadas pela cadeia de leds
+    uint8_t ledPortsCount;                          //!< Quantidade de portas em ledPorts (0 = escrita pino a pino)
+    led_run_t ledRuns[MAX_LED_RUNS];                //!< Trechos de leds consecutivos
+    uint8_t ledRunsCount;                           //!< Quantidade de trechos em ledRuns
+    bool resolvePorts();
+    void writePorts(const bits_frame_t *frame, const bits_frame_t *changed);
+    void writePins(const bits_frame_t *frame, const bits_frame_t *changed);
+protected:
+    void writeFrame(const bits_frame_t *frame, const bits_frame_t *changed);
+public:
+    GpioLedOutput(uint8_t initialPin = 0);
+    void setInitialPin(uint8_t initialPin);
+    void begin(uint8_t ledsCount);
+};
+
+#endif  //!__GPIOLEDOUTPUT__H__
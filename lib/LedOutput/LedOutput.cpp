@@ -0,0 +1,67 @@
+/**
+ * @file LedOutput.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Interface das saídas que acionam a cadeia de leds
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "LedOutput.h"
+
+/**
+ * @brief Constrói um novo objeto LedOutput
+ * 
+ */
+LedOutput::LedOutput(){
+    bits_frame_clear(&this->lastFrame);
+    this->lastFrameValid = false;
+    this->ledsCount = 0;
+    bits_frame_clear(&this->ledsMask);
+}
+
+/**
+ * @brief Inicializa a saída
+ * 
+ * @param ledsCount Quantidade de leds da cadeia (até FRAME_MAX_BITS)
+ */
+void LedOutput::begin(uint8_t ledsCount){
+    this->ledsCount = ledsCount;
+    bits_frame_fill(&this->ledsMask, ledsCount);
+    invalidate();
+}
+
+/**
+ * @brief Escreve um quadro nos leds, se ele for diferente do último quadro escrito
+ * 
+ * @param frame Estado dos leds, um bit por led
+ * @return true Se alguma saída foi escrita
+ * @return false Se o quadro é igual ao anterior
+ */
+bool LedOutput::write(const bits_frame_t *frame){
+    bits_frame_t masked = *frame;
+    bits_frame_t changed;
+
+    bits_frame_and(&masked, &this->ledsMask);
+    if(this->lastFrameValid){
+        bits_frame_xor(&changed, &masked, &this->lastFrame);
+        if(bits_frame_is_zero(&changed)) return false;
+    }else{
+        changed = this->ledsMask;
+    }
+
+    writeFrame(&masked, &changed);
+    this->lastFrame = masked;
+    this->lastFrameValid = true;
+    return true;
+}
+
+/**
+ * @brief Força a reescrita completa no próximo quadro
+ * 
+ */
+void LedOutput::invalidate(){
+    this->lastFrameValid = false;
+}
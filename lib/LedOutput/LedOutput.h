@@ -0,0 +1,42 @@
+/**
+ * @file LedOutput.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Interface das saídas que acionam a cadeia de leds
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __LEDOUTPUT__H__
+#define __LEDOUTPUT__H__
+
+#include "hal.h"
+#include "bits_frame.h"
+
+/**
+ * @brief Saída da cadeia de leds
+ * 
+ * Guarda o último quadro escrito: um quadro igual ao anterior não gera
+ * nenhuma escrita, e um quadro diferente é repassado ao backend junto com
+ * os bits que mudaram, para que apenas os grupos alterados sejam reescritos.
+ */
+class LedOutput
+{
+private:
+    bits_frame_t lastFrame;                         //!< Último quadro escrito
+    bool lastFrameValid;                            //!< lastFrame corresponde ao estado atual das saídas
+protected:
+    uint8_t ledsCount;                              //!< Quantidade de leds da cadeia
+    bits_frame_t ledsMask;                          //!< Máscara com um bit para cada led da cadeia
+    virtual void writeFrame(const bits_frame_t *frame, const bits_frame_t *changed) = 0;
+public:
+    LedOutput();
+    virtual ~LedOutput() {}
+    virtual void begin(uint8_t ledsCount);
+    bool write(const bits_frame_t *frame);
+    void invalidate();
+};
+
+#endif  //!__LEDOUTPUT__H__
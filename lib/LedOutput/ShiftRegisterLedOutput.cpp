@@ -0,0 +1,58 @@
+/**
+ * @file ShiftRegisterLedOutput.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Saída da cadeia de leds por registradores de deslocamento 74HC595 ligados ao SPI
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "ShiftRegisterLedOutput.h"
+
+#ifdef ARDUINO
+#include <SPI.h>
+#endif
+
+/**
+ * @brief Constrói um novo objeto ShiftRegisterLedOutput
+ * 
+ * @param latchPin Pino ligado ao RCLK dos 74HC595
+ */
+ShiftRegisterLedOutput::ShiftRegisterLedOutput(uint8_t latchPin){
+    this->latchPin = latchPin;
+}
+
+/**
+ * @brief Inicializa o SPI e o pino de latch
+ * 
+ * @param ledsCount Quantidade de leds da cadeia
+ */
+void ShiftRegisterLedOutput::begin(uint8_t ledsCount){
+    LedOutput::begin(ledsCount);
+    pinMode(this->latchPin, OUTPUT);
+    digitalWrite(this->latchPin, LOW);
+    SPI.begin();
+}
+
+/**
+ * @brief Desloca o quadro pela cascata de registradores e transfere para as saídas
+ * 
+ * @param frame Estado dos leds
+ * @param changed Leds que mudaram desde o último quadro (a cascata é sempre reescrita por inteiro)
+ */
+void ShiftRegisterLedOutput::writeFrame(const bits_frame_t *frame, const bits_frame_t *changed){
+    (void)changed;
+    uint8_t registers = (this->ledsCount + 7) / 8;
+
+    SPI.beginTransaction(SPISettings(SHIFT_REGISTER_SPI_CLOCK, MSBFIRST, SPI_MODE0));
+    for (uint8_t i = registers; i > 0; i--)
+    {
+        SPI.transfer(bits_frame_get_byte(frame, (i - 1) * 8));
+    }
+    SPI.endTransaction();
+
+    digitalWrite(this->latchPin, HIGH);
+    digitalWrite(this->latchPin, LOW);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file ShiftRegisterLedOutput.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Saída da cadeia de leds por registradores de deslocamento 74HC595 ligados ao SPI
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __SHIFTREGISTERLEDOUTPUT__H__
+#define __SHIFTREGISTERLEDOUTPUT__H__
+
+#include "LedOutput.h"
+
+#define SHIFT_REGISTER_SPI_CLOCK 8000000    //!< Frequência do SPI para os 74HC595
+
+/**
+ * @brief Saída por 74HC595 em cascata: MOSI no SER do primeiro, SCK no SRCLK e o pino de latch no RCLK
+ * 
+ * O led i corresponde à saída Q(i % 8) do registrador i / 8. Como a cascata
+ * precisa ser deslocada por inteiro, um quadro alterado reescreve todos os
+ * registradores; quadros iguais ao anterior não geram tráfego no SPI.
+ */
+class ShiftRegisterLedOutput : public LedOutput
+{
+private:
+    uint8_t latchPin;                               //!< Pino ligado ao RCLK dos 74HC595
+protected:
+    void writeFrame(const bits_frame_t *frame, const bits_frame_t *changed);
+public:
+    ShiftRegisterLedOutput(uint8_t latchPin);
+    void begin(uint8_t ledsCount);
+};
+
+#endif  //!__SHIFTREGISTERLEDOUTPUT__H__
@@ -0,0 +1,89 @@
+/**
+ * @file SimLedOutput.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Saída simulada da cadeia de leds, para execução no computador e medições
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "SimLedOutput.h"
+
+/**
+ * @brief Constrói um novo objeto SimLedOutput
+ * 
+ */
+SimLedOutput::SimLedOutput(){
+    bits_frame_clear(&this->frame);
+    this->frameTime = 0;
+    this->writes = 0;
+    this->groupWrites = 0;
+}
+
+/**
+ * @brief Inicializa a saída e zera os contadores
+ * 
+ * @param ledsCount Quantidade de leds da cadeia
+ */
+void SimLedOutput::begin(uint8_t ledsCount){
+    LedOutput::begin(ledsCount);
+    bits_frame_clear(&this->frame);
+    this->frameTime = micros();
+    this->writes = 0;
+    this->groupWrites = 0;
+}
+
+/**
+ * @brief Registra o quadro e os grupos alterados
+ * 
+ * @param frame Estado dos leds
+ * @param changed Leds que mudaram desde o último quadro
+ */
+void SimLedOutput::writeFrame(const bits_frame_t *frame, const bits_frame_t *changed){
+    this->frame = *frame;
+    this->frameTime = micros();
+    this->writes++;
+
+    for (uint16_t i = 0; i < this->ledsCount; i += 8)
+    {
+        if(bits_frame_get_byte(changed, i)) this->groupWrites++;
+    }
+}
+
+/**
+ * @brief Obtém o último quadro escrito
+ * 
+ * @return const bits_frame_t* Estado dos leds
+ */
+const bits_frame_t *SimLedOutput::getFrame(){
+    return &this->frame;
+}
+
+/**
+ * @brief Obtém o instante da última escrita
+ * 
+ * @return uint32_t Instante em microssegundos
+ */
+uint32_t SimLedOutput::getFrameTime(){
+    return this->frameTime;
+}
+
+/**
+ * @brief Obtém a quantidade de quadros escritos desde begin()
+ * 
+ * @return uint32_t Quantidade de quadros
+ */
+uint32_t SimLedOutput::getWrites(){
+    return this->writes;
+}
+
+/**
+ * @brief Obtém a quantidade de grupos de 8 leds reescritos desde begin()
+ * 
+ * @return uint32_t Quantidade de grupos
+ */
+uint32_t SimLedOutput::getGroupWrites(){
+    return this->groupWrites;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file SimLedOutput.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Saída simulada da cadeia de leds, para execução no computador e medições
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __SIMLEDOUTPUT__H__
+#define __SIMLEDOUTPUT__H__
+
+#include "LedOutput.h"
+
+/**
+ * @brief Saída que apenas registra os quadros recebidos, sem acionar nenhum pino
+ * 
+ * Os grupos contabilizados são bytes de 8 leds, como nos registradores de
+ * porta e nos 74HC595.
+ */
+class SimLedOutput : public LedOutput
+{
+private:
+    bits_frame_t frame;                             //!< Último quadro escrito
+    uint32_t frameTime;                             //!< Instante (micros) da última escrita
+    uint32_t writes;                                //!< Quantidade de quadros escritos
+    uint32_t groupWrites;                           //!< Quantidade de grupos de 8 leds reescritos
+protected:
+    void writeFrame(const bits_frame_t *frame, const bits_frame_t *changed);
+public:
+    SimLedOutput();
+    void begin(uint8_t ledsCount);
+    const bits_frame_t *getFrame();
+    uint32_t getFrameTime();
+    uint32_t getWrites();
+    uint32_t getGroupWrites();
+};
+
+#endif  //!__SIMLEDOUTPUT__H__
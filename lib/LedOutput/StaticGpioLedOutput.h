@@ -0,0 +1,102 @@
+/**
+ * @file StaticGpioLedOutput.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Saída por pinos consecutivos com o agrupamento por porta calculado em tempo de compilação
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __STATICGPIOLEDOUTPUT__H__
+#define __STATICGPIOLEDOUTPUT__H__
+
+#include "LedOutput.h"
+
+#ifdef HAL_UNO_PIN_MAP
+
+/**
+ * @brief Trecho da cadeia de leds ligado a uma porta, calculado em tempo de compilação
+ * 
+ * @tparam Port Porta (PD, PB ou PC)
+ * @tparam InitialPin Pino do primeiro led da cadeia
+ * @tparam LedCount Quantidade de leds da cadeia
+ */
+template<uint8_t Port, uint8_t InitialPin, uint8_t LedCount>
+struct StaticLedPort
+{
+    static constexpr uint8_t firstPin = hal_uno_port_first_pin(Port) > InitialPin ? hal_uno_port_first_pin(Port) : InitialPin;
+    static constexpr uint8_t lastPin = hal_uno_port_last_pin(Port) < InitialPin + LedCount - 1 ? hal_uno_port_last_pin(Port) : InitialPin + LedCount - 1;
+    static constexpr bool used = LedCount > 0 && firstPin <= lastPin;
+    static constexpr uint8_t firstLed = used ? firstPin - InitialPin : 0;
+    static constexpr uint8_t firstBit = used ? firstPin - hal_uno_port_first_pin(Port) : 0;
+    static constexpr uint8_t mask = used ? (uint8_t)(((1 << (lastPin - firstPin + 1)) - 1) << firstBit) : 0;
+
+    /**
+     * @brief Escreve a porta, se algum dos seus leds mudou
+     * 
+     * @param frame Estado dos leds
+     * @param changed Leds que mudaram desde o último quadro
+     */
+    static inline void write(const bits_frame_t *frame, const bits_frame_t *changed){
+        if(!used) return;
+        if(!((uint8_t)(bits_frame_get_byte(changed, firstLed) << firstBit) & mask)) return;
+        hal_port_write(hal_port_register(Port), mask, (uint8_t)(bits_frame_get_byte(frame, firstLed) << firstBit) & mask);
+    }
+};
+
+/**
+ * @brief Saída por pinos digitais consecutivos do Arduino Uno, com portas, máscaras e deslocamentos constantes
+ * 
+ * @tparam InitialPin Pino do primeiro led da cadeia
+ * @tparam LedCount Quantidade de leds da cadeia
+ */
+template<uint8_t InitialPin, uint8_t LedCount>
+class StaticGpioLedOutput : public LedOutput
+{
+    static_assert(InitialPin + LedCount <= 20, "A cadeia de leds ultrapassa o pino 19 do Arduino Uno");
+protected:
+    /**
+     * @brief Escreve as portas com leds alterados
+     * 
+     * @param frame Estado dos leds
+     * @param changed Leds que mudaram desde o último quadro
+     */
+    void writeFrame(const bits_frame_t *frame, const bits_frame_t *changed){
+        StaticLedPort<PD, InitialPin, LedCount>::write(frame, changed);
+        StaticLedPort<PB, InitialPin, LedCount>::write(frame, changed);
+        StaticLedPort<PC, InitialPin, LedCount>::write(frame, changed);
+
+#ifdef HAL_VERIFY_LED_PORTS
+        uint8_t ports[HAL_PORT_COUNT];
+        hal_ports_save(ports);
+        for (uint8_t i = 0; i < LedCount; i++)
+        {
+            digitalWrite(InitialPin + i, bits_frame_get(frame, i));
+        }
+        if(!hal_ports_equal(ports)){
+            fprintf(stderr, "StaticGpioLedOutput: escrita por porta difere da escrita pino a pino (leds %lu)\n", (unsigned long)frame->words[0]);
+            abort();
+        }
+#endif
+    }
+public:
+    /**
+     * @brief Configura os pinos como saída
+     * 
+     * @param ledsCount Quantidade de leds da cadeia (ignorada, a quantidade é LedCount)
+     */
+    void begin(uint8_t ledsCount){
+        (void)ledsCount;
+        LedOutput::begin(LedCount);
+        for (uint8_t i = 0; i < LedCount; i++)
+        {
+            pinMode(InitialPin + i, OUTPUT);
+        }
+    }
+};
+
+#endif  //!HAL_UNO_PIN_MAP
+
+#endif  //!__STATICGPIOLEDOUTPUT__H__
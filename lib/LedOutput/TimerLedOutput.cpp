@@ -0,0 +1,184 @@
+/**
+ * @file TimerLedOutput.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Atualização dos leds por interrupção de temporizador, com buffer duplo
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "TimerLedOutput.h"
+
+TimerLedOutput *TimerLedOutput::active = NULL;
+
+/**
+ * @brief Constrói um novo objeto TimerLedOutput
+ * 
+ * @param target Saída onde os quadros são publicados (ex.: GpioLedOutput)
+ * @param period Período de atualização, em microssegundos
+ */
+TimerLedOutput::TimerLedOutput(LedOutput *target, uint32_t period){
+    this->target = target;
+    this->period = period;
+    bits_frame_clear(&this->buffers[0]);
+    bits_frame_clear(&this->buffers[1]);
+    this->front = 0;
+    this->pending = false;
+    this->submitTime = 0;
+    this->lastRefresh = 0;
+    this->running = false;
+    resetStats();
+}
+
+/**
+ * @brief Inicializa a saída de destino e inicia o temporizador
+ * @note Se o temporizador não puder ser iniciado, os quadros são escritos diretamente na saída de destino
+ * 
+ * @param ledsCount Quantidade de leds da cadeia
+ */
+void TimerLedOutput::begin(uint8_t ledsCount){
+    end();
+    LedOutput::begin(ledsCount);
+    this->target->begin(ledsCount);
+
+    bits_frame_clear(&this->buffers[0]);
+    bits_frame_clear(&this->buffers[1]);
+    this->front = 0;
+    this->pending = false;
+    resetStats();
+
+    active = this;
+    this->lastRefresh = micros();
+    this->running = hal_timer_start(this->period, refreshInterrupt);
+    if(!this->running) active = NULL;
+}
+
+/**
+ * @brief Para o temporizador. Os quadros seguintes são escritos diretamente na saída de destino
+ * 
+ */
+void TimerLedOutput::end(){
+    if(active != this) return;
+
+    hal_timer_stop();
+    active = NULL;
+    this->running = false;
+}
+
+/**
+ * @brief Indica se os quadros estão sendo publicados pelo temporizador
+ * 
+ * @return true Se o temporizador está em execução
+ */
+bool TimerLedOutput::isRunning(){
+    return this->running;
+}
+
+/**
+ * @brief Obtém uma cópia das estatísticas da atualização
+ * 
+ * @return led_refresh_stats_t Estatísticas
+ */
+led_refresh_stats_t TimerLedOutput::getStats(){
+    led_refresh_stats_t copy;
+
+    noInterrupts();
+    copy.refreshes = this->stats.refreshes;
+    copy.swaps = this->stats.swaps;
+    copy.dropped = this->stats.dropped;
+    copy.periodMin = this->stats.periodMin;
+    copy.periodMax = this->stats.periodMax;
+    copy.latencyMax = this->stats.latencyMax;
+    copy.latencySum = this->stats.latencySum;
+    copy.entryMin = this->stats.entryMin;
+    copy.entryMax = this->stats.entryMax;
+    copy.updateMax = this->stats.updateMax;
+    interrupts();
+    return copy;
+}
+
+/**
+ * @brief Zera as estatísticas da atualização
+ * 
+ */
+void TimerLedOutput::resetStats(){
+    noInterrupts();
+    this->stats.refreshes = 0;
+    this->stats.swaps = 0;
+    this->stats.dropped = 0;
+    this->stats.periodMin = UINT32_MAX;
+    this->stats.periodMax = 0;
+    this->stats.latencyMax = 0;
+    this->stats.latencySum = 0;
+    this->stats.entryMin = UINT32_MAX;
+    this->stats.entryMax = 0;
+    this->stats.updateMax = 0;
+    interrupts();
+}
+
+/**
+ * @brief Escreve o quadro no buffer de trás e o marca como pronto para a próxima interrupção
+ * 
+ * @param frame Estado dos leds
+ * @param changed Leds que mudaram desde o último quadro (não utilizado: a saída de destino calcula a sua própria diferença)
+ */
+void TimerLedOutput::writeFrame(const bits_frame_t *frame, const bits_frame_t *changed){
+    (void)changed;
+
+    if(!this->running){
+        this->target->write(frame);
+        return;
+    }
+
+    if(this->pending) this->stats.dropped++;
+    this->pending = false;
+    hal_memory_barrier();
+    this->buffers[this->front ^ 1] = *frame;
+    this->submitTime = micros();
+    hal_memory_barrier();
+    this->pending = true;
+}
+
+/**
+ * @brief Rotina do temporizador
+ * 
+ */
+void TimerLedOutput::refreshInterrupt(){
+    if(active) active->refresh();
+}
+
+/**
+ * @brief Publica o buffer da frente, trocando os buffers se houver um quadro novo
+ * 
+ */
+void TimerLedOutput::refresh(){
+    uint32_t entry = hal_timer_cycles();
+    uint32_t now = micros();
+    uint32_t interval = now - this->lastRefresh;
+
+    this->lastRefresh = now;
+    if(entry < this->stats.entryMin) this->stats.entryMin = entry;
+    if(entry > this->stats.entryMax) this->stats.entryMax = entry;
+    if(this->stats.refreshes > 0){
+        if(interval < this->stats.periodMin) this->stats.periodMin = interval;
+        if(interval > this->stats.periodMax) this->stats.periodMax = interval;
+    }
+    this->stats.refreshes++;
+
+    if(this->pending){
+        uint32_t latency = now - this->submitTime;
+
+        this->front ^= 1;
+        this->pending = false;
+        this->stats.swaps++;
+        this->stats.latencySum += latency;
+        if(latency > this->stats.latencyMax) this->stats.latencyMax = latency;
+    }
+
+    this->target->write(&this->buffers[this->front]);
+
+    uint32_t update = hal_timer_cycles();
+    if(update > this->stats.updateMax) this->stats.updateMax = update;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file TimerLedOutput.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Atualização dos leds por interrupção de temporizador, com buffer duplo
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __TIMERLEDOUTPUT__H__
+#define __TIMERLEDOUTPUT__H__
+
+#include "LedOutput.h"
+
+#define LED_REFRESH_PERIOD 2000         //!< Período padrão de atualização dos leds, em microssegundos (500 Hz)
+
+/**
+ * @brief Estatísticas da atualização por temporizador, em microssegundos
+ */
+typedef struct
+{
+    uint32_t refreshes;                 //!< Quantidade de interrupções de atualização
+    uint32_t swaps;                     //!< Quadros novos publicados nas saídas
+    uint32_t dropped;                   //!< Quadros substituídos antes de serem publicados
+    uint32_t periodMin;                 //!< Menor intervalo entre duas atualizações
+    uint32_t periodMax;                 //!< Maior intervalo entre duas atualizações
+    uint32_t latencyMax;                //!< Maior atraso entre o quadro ser escrito e ser publicado
+    uint32_t latencySum;                //!< Soma dos atrasos, para o cálculo da média (latencySum / swaps)
+    uint32_t entryMin;                  //!< Menor atraso da interrupção, do fim do período até o início da atualização, em ciclos da CPU
+    uint32_t entryMax;                  //!< Maior atraso da interrupção, em ciclos da CPU (entryMax - entryMin é o jitter da atualização)
+    uint32_t updateMax;                 //!< Maior tempo do fim do período até o quadro estar escrito nas saídas, em ciclos da CPU
+}led_refresh_stats_t;
+
+/**
+ * @brief Saída que publica os quadros em outra saída a uma taxa fixa, pela interrupção do temporizador
+ * 
+ * A aplicação escreve no buffer de trás. A interrupção troca os buffers
+ * quando há um quadro novo completo e escreve o buffer da frente na saída
+ * de destino. A troca é feita apenas pela interrupção e a aplicação nunca
+ * desabilita as interrupções: antes de copiar um quadro ela retira o aviso
+ * de quadro pronto, então a interrupção nunca publica um quadro pela metade.
+ * Apenas uma TimerLedOutput pode estar ativa, pois utiliza o único
+ * temporizador da HAL (timer1 no AVR).
+ *
+ * Os intervalos e atrasos em microssegundos vêm de micros() (resolução de
+ * 4 us no AVR a 16 MHz). O atraso da interrupção e da escrita nas saídas é
+ * medido em ciclos pelo contador do timer1 (hal_timer_cycles). No ambiente
+ * native o relógio virtual dispara a interrupção no instante exato, então
+ * os períodos são exatos e os atrasos em ciclos são 0: o jitter real só é
+ * medido na placa.
+ */
+class TimerLedOutput : public LedOutput
+{
+private:
+    static TimerLedOutput *active;                  //!< Saída atendida pela interrupção do temporizador
+    LedOutput *target;                              //!< Saída onde os quadros são publicados
+    uint32_t period;                                //!< Período de atualização, em microssegundos
+    bits_frame_t buffers[2];                        //!< Buffers da frente e de trás
+    volatile uint8_t front;                         //!< Índice do buffer da frente, publicado pela interrupção
+    volatile bool pending;                          //!< O buffer de trás contém um quadro completo ainda não publicado
+    volatile uint32_t submitTime;                   //!< Instante (micros) em que o quadro pendente foi escrito
+    uint32_t lastRefresh;                           //!< Instante (micros) da última interrupção
+    bool running;                                   //!< Temporizador em execução
+    volatile led_refresh_stats_t stats;             //!< Estatísticas da atualização
+    static void refreshInterrupt();
+    void refresh();
+protected:
+    void writeFrame(const bits_frame_t *frame, const bits_frame_t *changed);
+public:
+    TimerLedOutput(LedOutput *target, uint32_t period = LED_REFRESH_PERIOD);
+    void begin(uint8_t ledsCount);
+    void end();
+    bool isRunning();
+    led_refresh_stats_t getStats();
+    void resetStats();
+};
+
+#endif  //!__TIMERLEDOUTPUT__H__
@@ -0,0 +1,92 @@
+/**
+ * @file RouletteController.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Controlador de várias roletas eletrônicas em um único microcontrolador
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "RouletteController.h"
+
+/**
+ * @brief Constrói um novo objeto RouletteController, sem roletas
+ * 
+ */
+RouletteController::RouletteController(){
+    this->roulettesCount = 0;
+    timer_wheel_init(&this->scheduler);
+}
+
+/**
+ * @brief Adiciona uma roleta ao controlador. Deve ser chamada antes de begin()
+ * @note Configure os pinos da roleta (leds, botões e buzzer) antes de adicioná-la
+ * 
+ * @param roulette Roleta a ser controlada
+ * @return true Se a roleta foi adicionada
+ * @return false Se o controlador já possui ROULETTE_CONTROLLER_MAX roletas
+ */
+bool RouletteController::add(ElectronicRoulette *roulette){
+    if(roulette == NULL || this->roulettesCount >= ROULETTE_CONTROLLER_MAX) return false;
+
+    roulette->setTraceId(this->roulettesCount);
+    this->roulettes[this->roulettesCount++] = roulette;
+    return true;
+}
+
+/**
+ * @brief Inicializa todas as roletas e agenda a primeira execução de cada uma
+ * 
+ */
+void RouletteController::begin(){
+    timer_wheel_init(&this->scheduler);
+
+    for (uint8_t i = 0; i < this->roulettesCount; i++)
+    {
+        this->roulettes[i]->begin();
+        timer_wheel_schedule(&this->scheduler, i, millis());
+    }
+}
+
+/**
+ * @brief Executa as roletas cujo prazo chegou, ou que tiveram um botão pressionado
+ * @note O loop pode dormir até o instante retornado (ex.: hal_sleep_until), desde que acorde com os botões
+ * 
+ * @return uint32_t Instante (millis) em que alguma roleta precisa ser atualizada novamente
+ */
+uint32_t RouletteController::task(){
+    for (uint8_t i = 0; i < this->roulettesCount; i++)
+    {
+        if(this->roulettes[i]->hasButtonEvents()) timer_wheel_schedule(&this->scheduler, i, millis());
+    }
+
+    uint8_t due = timer_wheel_expire(&this->scheduler);
+
+    for (uint8_t i = 0; due; i++, due >>= 1)
+    {
+        if(due & 1) timer_wheel_schedule(&this->scheduler, i, this->roulettes[i]->task());
+    }
+
+    return timer_wheel_next(&this->scheduler, millis() + MAX_SLEEP_TIME);
+}
+
+/**
+ * @brief Obtém a quantidade de roletas controladas
+ * 
+ * @return uint8_t Quantidade de roletas
+ */
+uint8_t RouletteController::getCount(){
+    return this->roulettesCount;
+}
+
+/**
+ * @brief Obtém uma roleta do controlador
+ * 
+ * @param index Índice da roleta, na ordem em que foi adicionada
+ * @return ElectronicRoulette* Roleta, ou NULL se o índice não existe
+ */
+ElectronicRoulette *RouletteController::get(uint8_t index){
+    return index < this->roulettesCount ? this->roulettes[index] : NULL;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file RouletteController.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Controlador de várias roletas eletrônicas em um único microcontrolador
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __ROULETTECONTROLLER__H__
+#define __ROULETTECONTROLLER__H__
+
+#include "hal.h"
+#include "timer_wheel.h"
+#include "ElectronicRoulette.h"
+
+#ifndef ROULETTE_CONTROLLER_MAX
+#if defined(__AVR__) && RAMEND < 0x900
+#define ROULETTE_CONTROLLER_MAX 3                       //!< Quantidade máxima de roletas por controlador. No ATmega328P cada roleta ocupa cerca de 270 bytes de RAM
+#else
+#define ROULETTE_CONTROLLER_MAX TIMER_WHEEL_MAX_TASKS   //!< Quantidade máxima de roletas por controlador
+#endif
+#endif
+
+#ifdef __AVR__
+#define ROULETTE_CONTROLLER_RAM ((RAMEND - RAMSTART + 1) / 2)   //!< RAM disponível para as roletas. A outra metade fica para o trace, a telemetria, a serial, os comandos e a pilha
+#endif
+
+static_assert(ROULETTE_CONTROLLER_MAX <= TIMER_WHEEL_MAX_TASKS, "ROULETTE_CONTROLLER_MAX ultrapassa as tarefas da roda de temporização");
+#ifdef ROULETTE_CONTROLLER_RAM
+static_assert(ROULETTE_CONTROLLER_MAX * sizeof(ElectronicRoulette) <= ROULETTE_CONTROLLER_RAM, "ROULETTE_CONTROLLER_MAX roletas não cabem na RAM do microcontrolador");
+#endif
+
+/**
+ * @brief Executa várias roletas em um único loop sem bloqueio
+ * 
+ * Cada roleta mantém os seus pinos, estado e lista de sorteio. O controlador
+ * só chama task() das roletas cujo prazo chegou, agendadas em uma roda de
+ * temporização, e executa imediatamente a roleta que teve um botão
+ * pressionado.
+ *
+ * As roletas são criadas pela aplicação, e cada uma ocupa
+ * sizeof(ElectronicRoulette) bytes de RAM: cerca de 270 bytes no ATmega328P,
+ * a maior parte na fila dos botões, nos pinos da GpioLedOutput, na lista de
+ * 24 números e nos efeitos. Por isso o Arduino Uno aceita até 3 roletas; em
+ * microcontroladores com mais RAM, até TIMER_WHEEL_MAX_TASKS.
+ */
+class RouletteController
+{
+private:
+    ElectronicRoulette *roulettes[ROULETTE_CONTROLLER_MAX];     //!< Roletas controladas
+    uint8_t roulettesCount;                                     //!< Quantidade de roletas controladas
+    timer_wheel_t scheduler;                                    //!< Prazo de cada roleta
+public:
+    RouletteController();
+    bool add(ElectronicRoulette *roulette);
+    void begin();
+    uint32_t task();
+    uint8_t getCount();
+    ElectronicRoulette *get(uint8_t index);
+};
+
+#endif  //!__ROULETTECONTROLLER__H__
@@ -0,0 +1,556 @@
+/**
+ * @file SerialCommand.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Protocolo de comandos pela serial, para configurar e acionar as roletas sem regravar o firmware
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "SerialCommand.h"
+
+/**
+ * @brief Comandos
+ */
+enum
+{
+    COMMAND_GET,
+    COMMAND_SET,
+    COMMAND_READY,
+    COMMAND_START,
+    COMMAND_DUMP,
+    COMMAND_SYNC,
+    COMMAND_PUSH,
+    COMMAND_COUNT
+};
+
+/**
+ * @brief Parâmetros de get e set
+ */
+enum
+{
+    PARAM_SPEED,
+    PARAM_DECEL,
+    PARAM_STOP,
+    PARAM_SPINTIME,
+    PARAM_PLANNER,
+    PARAM_EASING,
+    PARAM_TONE,
+    PARAM_BUZZ,
+    PARAM_LEDS,
+    PARAM_LIST,
+    PARAM_STATE,
+    PARAM_DURATION,
+    PARAM_QUEUE,
+    PARAM_COUNT
+};
+
+/**
+ * Variáveis globais
+ */
+const char serialCommandNames[COMMAND_COUNT][6] PROGMEM = {"get", "set", "ready", "start", "dump", "sync", "push"};     //!< Nomes dos comandos
+const char serialCommandParams[PARAM_COUNT][9] PROGMEM = {"speed", "decel", "stop", "spintime", "planner", "easing", "tone", "buzz", "leds", "list", "state", "duration", "queue"};  //!< Nomes dos parâmetros
+const char serialCommandStates[4][8] PROGMEM = {"idle", "ready", "drawing", "drawn"};  //!< Nomes dos estados da roleta (ElectronicRouletteState)
+
+/**
+ * @brief Converte um número decimal
+ * 
+ * @param text Texto com apenas dígitos
+ * @param max Maior valor aceito
+ * @param value Destino do valor
+ * @return true Se o texto é um número entre 0 e max
+ */
+bool serialCommandParseNumber(const char *text, uint32_t max, uint32_t *value){
+    *value = 0;
+    if(*text == '\0') return false;
+
+    for (; *text; text++)
+    {
+        if(*text < '0' || *text > '9') return false;
+        *value = *value * 10 + (*text - '0');
+        if(*value > max) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Procura um nome em uma tabela na memória de programa
+ * 
+ * @param name Nome procurado
+ * @param table Tabela de nomes
+ * @param width Tamanho de cada nome da tabela
+ * @param count Quantidade de nomes da tabela
+ * @return uint8_t Índice do nome, ou count se não encontrado
+ */
+uint8_t serialCommandLookup(const char *name, const char *table, uint8_t width, uint8_t count){
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if(strcmp_P(name, table + i * width) == 0) return i;
+    }
+    return count;
+}
+
+/**
+ * Métodos públicos
+ */
+
+/**
+ * @brief Constrói um novo objeto Serial Command:: Serial Command para uma roleta
+ * 
+ * @param roulette Roleta controlada pelos comandos
+ */
+SerialCommand::SerialCommand(ElectronicRoulette *roulette){
+    this->roulette = roulette;
+    this->controller = NULL;
+    this->lineLength = 0;
+    this->lineReady = false;
+    this->lineOverflow = false;
+    this->position = 0;
+    this->target = 0;
+    this->replyLength = 0;
+    this->dumping = false;
+    this->dumpIndex = 0;
+    this->traceMask = TRACE_MASK_ALL;
+}
+
+/**
+ * @brief Constrói um novo objeto Serial Command:: Serial Command para as roletas de um controlador
+ * 
+ * @param controller Controlador das roletas. A roleta de cada comando é escolhida com "@n"
+ */
+SerialCommand::SerialCommand(RouletteController *controller) : SerialCommand((ElectronicRoulette *)NULL){
+    this->controller = controller;
+}
+
+/**
+ * @brief Lê os bytes recebidos e executa os comandos das linhas completas. Não bloqueia
+ * @note Deve ser chamada no loop, junto com telemetry_flush(), que envia as respostas
+ * 
+ */
+void SerialCommand::task(){
+    if(this->dumping){
+        dumpTrace();
+        if(this->dumping) return;
+    }
+
+    while (this->lineReady || readLine())
+    {
+        if(telemetry_space() < COMMAND_REPLY_SIZE + 8) return;
+
+        if(this->lineOverflow){
+            append(PSTR("err line"));
+            send();
+            this->lineOverflow = false;
+            this->lineReady = false;
+            this->lineLength = 0;
+            continue;
+        }
+
+        char *command = &this->line[this->position];
+        char *end = strchr(command, ';');
+
+        if(end){
+            *end = '\0';
+            this->position = end - this->line + 1;
+        }else{
+            this->position = this->lineLength;
+        }
+        if(this->position >= this->lineLength){
+            this->lineReady = false;
+            this->lineLength = 0;
+        }
+
+        execute(command);
+        if(this->dumping) return;
+    }
+}
+
+/**
+ * Métodos privados
+ */
+
+/**
+ * @brief Lê os bytes recebidos até completar uma linha
+ * 
+ * @return true Se uma linha foi completada (possivelmente com lineOverflow)
+ */
+bool SerialCommand::readLine(){
+    while (Serial.available() > 0)
+    {
+        char c = Serial.read();
+
+        if(c == '\n' || c == '\r'){
+            if(this->lineLength == 0 && !this->lineOverflow) continue;
+
+            this->line[this->lineLength] = '\0';
+            this->lineReady = true;
+            this->position = 0;
+            this->target = 0;
+            return true;
+        }
+
+        if(this->lineLength < COMMAND_LINE_SIZE - 1) this->line[this->lineLength++] = c;
+        else this->lineOverflow = true;
+    }
+    return false;
+}
+
+/**
+ * @brief Executa um comando, deixando a sua resposta no buffer de transmissão
+ * 
+ * @param command Texto do comando, alterado durante a separação das palavras
+ */
+void SerialCommand::execute(char *command){
+    char *tokens[COMMAND_MAX_TOKENS];
+    uint8_t count = 0;
+
+    while (*command)
+    {
+        if(*command == ' '){
+            *command++ = '\0';
+            continue;
+        }
+        if(count == COMMAND_MAX_TOKENS){
+            append(PSTR("err args"));
+            send();
+            return;
+        }
+        tokens[count++] = command;
+        while (*command && *command != ' ') command++;
+    }
+    if(count == 0) return;
+
+    if(tokens[0][0] == '@'){
+        uint32_t index;
+        uint8_t roulettes = this->controller ? this->controller->getCount() : 1;
+
+        if(count == 1 && roulettes > 0 && serialCommandParseNumber(&tokens[0][1], roulettes - 1, &index)){
+            this->target = index;
+            append(PSTR("ok"));
+        }else{
+            append(PSTR("err roulette"));
+        }
+        send();
+        return;
+    }
+
+    uint8_t id = serialCommandLookup(tokens[0], serialCommandNames[0], sizeof(serialCommandNames[0]), COMMAND_COUNT);
+    uint8_t param = count > 1 ? serialCommandLookup(tokens[1], serialCommandParams[0], sizeof(serialCommandParams[0]), PARAM_COUNT) : (uint8_t)PARAM_COUNT;
+    ElectronicRoulette *roulette = getTarget();
+
+    if(roulette == NULL){
+        append(PSTR("err roulette"));
+    }else if(id == COMMAND_COUNT){
+        append(PSTR("err cmd"));
+    }else if(count != (id == COMMAND_SET ? 3 : (id == COMMAND_GET || id == COMMAND_PUSH ? 2 : 1))){
+        append(PSTR("err args"));
+    }else if((id == COMMAND_GET || id == COMMAND_SET) && param == PARAM_COUNT){
+        append(PSTR("err param"));
+    }else{
+        switch (id)
+        {
+        case COMMAND_GET:
+            executeGet(roulette, param);
+            break;
+        case COMMAND_SET:
+            executeSet(roulette, param, tokens[2]);
+            break;
+        case COMMAND_READY:
+            roulette->commandReady();
+            append(PSTR("ok"));
+            break;
+        case COMMAND_START:
+            roulette->commandStart();
+            append(PSTR("ok"));
+            break;
+        case COMMAND_DUMP:
+            this->traceMask = trace_get_mask();
+            trace_set_mask(0);
+            this->dumping = true;
+            this->dumpIndex = 0;
+            append(PSTR("dump="));
+            appendNumber(trace_count());
+            break;
+        case COMMAND_SYNC:
+            telemetry_resync();
+            append(PSTR("ok"));
+            break;
+        case COMMAND_PUSH:
+            executePush(roulette, tokens[1]);
+            break;
+        }
+    }
+    send();
+}
+
+/**
+ * @brief Executa o comando get
+ * 
+ * @param roulette Roleta do comando
+ * @param param Parâmetro lido
+ */
+void SerialCommand::executeGet(ElectronicRoulette *roulette, uint8_t param){
+    append(serialCommandParams[param]);
+    append(PSTR("="));
+
+    switch (param)
+    {
+    case PARAM_SPEED:
+        appendNumber(roulette->getSpeed());
+        break;
+    case PARAM_DECEL:
+        appendNumber(roulette->getDeceleration());
+        break;
+    case PARAM_STOP:
+        appendNumber(roulette->getDuration());
+        break;
+    case PARAM_SPINTIME:
+        appendNumber(roulette->getSpinTime());
+        break;
+    case PARAM_PLANNER:
+        appendNumber(roulette->getStopPlanner());
+        break;
+    case PARAM_EASING:
+        appendNumber(roulette->getEasing());
+        break;
+    case PARAM_TONE:
+        appendNumber(roulette->getBuzzerTone());
+        break;
+    case PARAM_BUZZ:
+        appendNumber(roulette->getBuzzerDuration());
+        break;
+    case PARAM_LEDS:
+        appendNumber(roulette->getLedCount());
+        break;
+    case PARAM_LIST:
+    {
+        uint8_t numbers[DEFAULT_LIST_SIZE];
+
+        if(!roulette->getNumbersList(numbers)){
+            append(roulette->getDrawSource() ? PSTR("source") : PSTR("random"));
+            break;
+        }
+        for (uint8_t i = 0; i < DEFAULT_LIST_SIZE; i++)
+        {
+            if(i > 0) append(PSTR(","));
+            appendNumber(numbers[i]);
+        }
+        break;
+    }
+    case PARAM_STATE:
+        append(serialCommandStates[roulette->getState()]);
+        break;
+    case PARAM_DURATION:
+        appendNumber(roulette->getSpinDuration());
+        break;
+    case PARAM_QUEUE:
+        appendNumber(roulette->getDrawSource() ? roulette->getDrawSource()->space() : 0);
+        break;
+    }
+}
+
+/**
+ * @brief Executa o comando set
+ * 
+ * @param roulette Roleta do comando
+ * @param param Parâmetro alterado
+ * @param value Texto do novo valor
+ */
+void SerialCommand::executeSet(ElectronicRoulette *roulette, uint8_t param, char *value){
+    static const uint32_t limits[PARAM_LIST] = {100, 0xFF, 0xFF, SPIN_PROFILE_MAX_SPIN_TIME, 1, SPIN_EASING_COUNT - 1, 0xFFFF, 0xFF, FRAME_MAX_BITS};
+    uint32_t number = 0;
+
+    if(param >= PARAM_STATE){
+        append(PSTR("err readonly"));
+        return;
+    }
+    if((param == PARAM_SPEED || param == PARAM_DECEL || param == PARAM_STOP || param == PARAM_LEDS) && roulette->isConfigFixed()){
+        append(PSTR("err fixed"));
+        return;
+    }
+    if(param != PARAM_TONE && param != PARAM_BUZZ && roulette->getState() == ElectronicRouletteState::ST_DRAWING){
+        append(PSTR("err busy"));
+        return;
+    }
+    if(param != PARAM_LIST && (!serialCommandParseNumber(value, limits[param], &number) || (param == PARAM_LEDS && number == 0))){
+        append(PSTR("err value"));
+        return;
+    }
+
+    switch (param)
+    {
+    case PARAM_SPEED:
+        roulette->setSpeed(number);
+        break;
+    case PARAM_DECEL:
+        roulette->setDeceleration(number);
+        break;
+    case PARAM_STOP:
+        roulette->setDuration(number);
+        break;
+    case PARAM_SPINTIME:
+        roulette->setSpinTime(number);
+        break;
+    case PARAM_PLANNER:
+        roulette->setStopPlanner(number);
+        break;
+    case PARAM_EASING:
+        roulette->setEasing((spin_easing_t)number);
+        break;
+    case PARAM_TONE:
+        roulette->setBuzzerTone(number);
+        break;
+    case PARAM_BUZZ:
+        roulette->setBuzzerDuration(number);
+        break;
+    case PARAM_LEDS:
+        roulette->setLedCount(number);
+        break;
+    case PARAM_LIST:
+    {
+        uint8_t numbers[DEFAULT_LIST_SIZE];
+        uint8_t count = 0;
+        char *item = value;
+
+        if(strcmp_P(value, PSTR("random")) == 0){
+            roulette->setNumbersList(NULL);
+            break;
+        }
+        while (count < DEFAULT_LIST_SIZE)
+        {
+            char *end = strchr(item, ',');
+            if(end) *end = '\0';
+            if(!serialCommandParseNumber(item, roulette->getLedCount(), &number) || number == 0) break;
+            numbers[count++] = number;
+            if(!end) break;
+            item = end + 1;
+        }
+        if(count != DEFAULT_LIST_SIZE){
+            append(PSTR("err value"));
+            return;
+        }
+        roulette->setNumbersList(numbers);
+        break;
+    }
+    }
+    append(PSTR("ok"));
+}
+
+/**
+ * @brief Executa o comando push, que acrescenta números à fonte dos sorteios (ex.: RingDrawSource em fila)
+ * @note Os números só são acrescentados se todos forem válidos e couberem na fonte. A resposta traz o espaço restante
+ * 
+ * @param roulette Roleta do comando
+ * @param value Números separados por vírgula (1 a ledsCount)
+ */
+void SerialCommand::executePush(ElectronicRoulette *roulette, char *value){
+    uint8_t numbers[COMMAND_LINE_SIZE / 2];
+    uint8_t count = 0;
+    uint32_t number;
+    DrawSource *source = roulette->getDrawSource();
+
+    if(source == NULL){
+        append(PSTR("err source"));
+        return;
+    }
+    while (count < sizeof(numbers))
+    {
+        char *end = strchr(value, ',');
+        if(end) *end = '\0';
+        if(!serialCommandParseNumber(value, roulette->getLedCount(), &number) || number == 0){
+            append(PSTR("err value"));
+            return;
+        }
+        numbers[count++] = number - 1;
+        if(!end) break;
+        value = end + 1;
+    }
+    if(count > source->space()){
+        append(PSTR("err full"));
+        return;
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        source->push(numbers[i]);
+    }
+    append(PSTR("push="));
+    appendNumber(source->space());
+}
+
+/**
+ * @brief Envia os registros do trace enquanto houver espaço no buffer de transmissão
+ * @note A gravação fica pausada durante o envio, para que os índices dos registros não mudem
+ * 
+ */
+void SerialCommand::dumpTrace(){
+    trace_record_t record;
+    uint8_t buffer[TRACE_RECORD_SIZE];
+
+    while (trace_get(this->dumpIndex, &record))
+    {
+        trace_pack(&record, buffer);
+        if(!telemetry_send(TELEMETRY_TRACE, buffer, TRACE_RECORD_SIZE)) return;
+        this->dumpIndex++;
+    }
+
+    trace_set_mask(this->traceMask);
+    this->dumping = false;
+}
+
+/**
+ * @brief Obtém a roleta dos comandos
+ * 
+ * @return ElectronicRoulette* Roleta escolhida com "@n" (NULL se não existe)
+ */
+ElectronicRoulette *SerialCommand::getTarget(){
+    if(this->controller) return this->controller->get(this->target);
+    return this->target == 0 ? this->roulette : NULL;
+}
+
+/**
+ * @brief Acrescenta um texto da memória de programa à resposta
+ * 
+ * @param text Texto (PSTR ou tabela PROGMEM)
+ */
+void SerialCommand::append(const char *text){
+    char c;
+
+    while ((c = pgm_read_byte(text++)) != '\0' && this->replyLength < COMMAND_REPLY_SIZE)
+    {
+        this->reply[this->replyLength++] = c;
+    }
+}
+
+/**
+ * @brief Acrescenta um número decimal à resposta
+ * 
+ * @param value Número
+ */
+void SerialCommand::appendNumber(uint32_t value){
+    char digits[10];
+    uint8_t count = 0;
+
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+
+    while (count > 0 && this->replyLength < COMMAND_REPLY_SIZE)
+    {
+        this->reply[this->replyLength++] = digits[--count];
+    }
+}
+
+/**
+ * @brief Coloca a resposta no buffer de transmissão
+ * @note task() só executa um comando quando há espaço para a maior resposta
+ * 
+ */
+void SerialCommand::send(){
+    telemetry_send(TELEMETRY_REPLY, (const uint8_t *)this->reply, this->replyLength);
+    this->replyLength = 0;
+}
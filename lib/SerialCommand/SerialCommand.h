@@ -0,0 +1,82 @@
+/**
+ * @file SerialCommand.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Protocolo de comandos pela serial, para configurar e acionar as roletas sem regravar o firmware
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __SERIALCOMMAND__H__
+#define __SERIALCOMMAND__H__
+
+#include "hal.h"
+#include "ElectronicRoulette.h"
+#include "RouletteController.h"
+#include "telemetry.h"
+#include "trace.h"
+
+#define COMMAND_LINE_SIZE 64            //!< Tamanho máximo de uma linha recebida, incluindo o terminador
+#define COMMAND_REPLY_SIZE 80           //!< Tamanho máximo de uma resposta
+#define COMMAND_MAX_TOKENS 3            //!< Quantidade máxima de palavras de um comando
+
+/**
+ * @brief Executa comandos em texto recebidos pela serial
+ * 
+ * Cada linha (terminada em '\n' ou '\r') pode conter vários comandos
+ * separados por ';'. Um comando "@n" escolhe a roleta dos comandos
+ * seguintes da linha (padrão 0). Comandos:
+ * - get <parâmetro>: responde "<parâmetro>=<valor>"
+ * - set <parâmetro> <valor>: responde "ok"
+ * - ready, start: equivalem aos botões que preparam a roleta e iniciam o sorteio
+ * - dump: envia os registros do gravador de eventos (trace)
+ * - sync: faz a telemetria enviar o estado completo de todas as roletas
+ * - push <números>: acrescenta números separados por vírgula à fonte dos
+ *   sorteios (ex.: RingDrawSource em fila) e responde "push=<espaço livre>"
+ * 
+ * Parâmetros: speed, decel, stop, spintime, planner, easing, tone, buzz,
+ * leds, list (24 números separados por vírgula, ou random), e os somente
+ * leitura state, duration e queue (espaço livre da fonte dos sorteios). Os
+ * erros respondem "err <motivo>". Os parâmetros do giro não podem ser
+ * alterados durante o sorteio ("err busy"), e speed, decel, stop e leds não
+ * podem ser alterados em uma StaticElectronicRoulette ("err fixed").
+ * 
+ * Tudo é feito em buffers fixos, sem alocação. As respostas seguem pela
+ * telemetria (TELEMETRY_REPLY), e um comando só é executado quando a sua
+ * resposta cabe no buffer de transmissão, então task() nunca espera a serial.
+ */
+class SerialCommand
+{
+private:
+    ElectronicRoulette *roulette;                   //!< Roleta controlada, quando não há controlador
+    RouletteController *controller;                 //!< Controlador das roletas (NULL = uma roleta)
+    char line[COMMAND_LINE_SIZE];                   //!< Linha recebida
+    uint8_t lineLength;                             //!< Quantidade de caracteres da linha
+    bool lineReady;                                 //!< Indica que a linha está completa e tem comandos a executar
+    bool lineOverflow;                              //!< Indica que a linha recebida não coube no buffer
+    uint8_t position;                               //!< Início do próximo comando da linha
+    uint8_t target;                                 //!< Roleta dos comandos da linha
+    char reply[COMMAND_REPLY_SIZE];                 //!< Resposta do comando em execução
+    uint8_t replyLength;                            //!< Tamanho da resposta
+    bool dumping;                                   //!< Indica que os registros do trace estão sendo enviados
+    uint8_t dumpIndex;                              //!< Próximo registro do trace a ser enviado
+    uint8_t traceMask;                              //!< Máscara do trace antes do dump (a gravação é pausada durante o dump)
+    bool readLine();
+    void execute(char *command);
+    void executeGet(ElectronicRoulette *roulette, uint8_t param);
+    void executeSet(ElectronicRoulette *roulette, uint8_t param, char *value);
+    void executePush(ElectronicRoulette *roulette, char *value);
+    void dumpTrace();
+    ElectronicRoulette *getTarget();
+    void append(const char *text);
+    void appendNumber(uint32_t value);
+    void send();
+public:
+    SerialCommand(ElectronicRoulette *roulette);
+    SerialCommand(RouletteController *controller);
+    void task();
+};
+
+#endif  //!__SERIALCOMMAND__H__
@@ -11,336 +11,209 @@
 
 #include "bits_effects.h"
 
-/**
- * Variáveis globais
- */
-bits_effects_t bits_effects;        //!< Instância da estrutura de dados para controlar os efeitos
-uint8_t i;                          //!< Índice auxiliar para controlar os efeitos
-uint32_t time;                      //!< Tempo calculado com base na velocidade do efeito, e as constantes de delay (DEFAULT_MAX_DELAY, DEFAULT_MIN_DELAY)
-uint32_t all_on;                    //!< Estado calculado que permite acionar todos os bits da cadeia de bits configurada
-
 /**
  * Protótipos das funções privadas
  */
-void bits_effects_delay();
-void bits_effects_print_bits();
+void bits_effects_run(bits_effects_t *effects, const uint8_t *program);
+void bits_effects_delay(bits_effects_t *effects, uint8_t periods);
+void bits_effects_print_bits(const bits_effects_t *effects);
 
 /**
  * Efeitos
- */
-
-/**
- * @brief Acende os leds do primeiro para o último
- * 
- */
-void bits_effects_ramp_up_on(){
-    static bool effect_started = false;
-
-    if(!effect_started){
-        i = 0;
-        bits_effects.bits = 0;
-        effect_started = true;
-        return;
-    }
-
-    if(i >= bits_effects.size){
-        effect_started = false;
-        bits_effects.effect_done = true;
-        return;
-    }
-
-    bitSet(bits_effects.bits, i);
-    i++;
-
-    bits_effects_delay();
-}
-
-/**
- * @brief Apaga os leds do primeiro para o último
- * 
- */
-void bits_effects_ramp_up_off(){
-    static bool effect_started = false;
-
-    if(!effect_started){
-        i = 0;
-        bits_effects.bits = all_on;
-        effect_started = true;
-        return;
-    }
-
-    if(i >= bits_effects.size){
-        effect_started = false;
-        bits_effects.effect_done = true;
-        return;
-    }
-
-    bitClear(bits_effects.bits, i);
-    i++;
-
-    bits_effects_delay();
-}
-
-/**
- * @brief Acende os leds do último para o primeiro
  * 
+ * Cada efeito é um programa de instruções bits_effects_op_t. O número no
+ * comentário de cada linha é a posição da primeira instrução da linha,
+ * utilizada como destino dos saltos.
  */
-void bits_effects_ramp_down_on(){
-    static bool effect_started = false;
-
-    if(!effect_started){
-        bits_effects.bits = 0;
-        i = bits_effects.size ;
-        effect_started = true;
-        return;
-    }
-
-    i--;
-    bitSet(bits_effects.bits, i);
-
-    bits_effects_delay();
 
-    if(i <= 0){
-        effect_started = false;
-        bits_effects.effect_done = true;
-        return;
-    }
-}
-
-/**
- * @brief Apaga os leds do último para o primeiro
- * 
- */
-void bits_effects_ramp_down_off(){
-    static bool effect_started = false;
-
-    if(!effect_started){
-        bits_effects.bits = all_on;
-        i = bits_effects.size;
-        effect_started = true;
-        return;
-    }
-
-
-    i--;
-    bitClear(bits_effects.bits, i);
-
-    bits_effects_delay();
-
-    if(i <= 0){
-        effect_started = false;
-        bits_effects.effect_done = true;
-        return;
-    }
-}
-
-/**
- * @brief Inverte os leds do primeiro para o último
- * 
- */
-void bits_effects_flash_swap_up(){
-    static bool effect_started = false;
-
-    if(!effect_started){
-        bits_effects.bits = all_on / 3;
-        effect_started = true;
-        i = 0;
-        return;
-    }
-
-    bits_effects.bits = bits_effects.bits << 1;
-    i++;
-
-    bits_effects_delay();
-    bits_effects_delay();
-
-    if(i >= bits_effects.size){
-        effect_started = false;
-        bits_effects.effect_done = true;
-        return;
-    }
-}
-
-/**
- * @brief Inverte os leds do último para o primeiro
- * 
- */
-void bits_effects_flash_swap_down(){
-    static bool effect_started = false;
-
-    if(!effect_started){
-        bits_effects.bits = (all_on / 3) << 1;
-        effect_started = true;
-        i = 0;
-        return;
-    }
-
-    bits_effects.bits = bits_effects.bits >> 1;
-    i++;
-
-    bits_effects_delay();
-    bits_effects_delay();
-
-    if(i >= bits_effects.size){
-        effect_started = false;
-        bits_effects.effect_done = true;
-        return;
-    }
-}
-
-/**
- * @brief Inverte os leds mantendo a sequencia estática
- * 
- */
-void bits_effects_flash_swap(){
-    static bool effect_started = false;
-
-    if(!effect_started){
-        bits_effects.bits = all_on / 3;
-        effect_started = true;
-        i = 0;
-        return;
-    }
-
-    if(i % 2 == 0) bits_effects.bits = bits_effects.bits << 1;
-    else bits_effects.bits = bits_effects.bits >> 1;
-    i++;
+//! Acende os leds do primeiro para o último
+const uint8_t bits_effects_ramp_up_on[] PROGMEM = {
+    OP_FILL_ZERO, OP_I_ZERO, OP_YIELD,                          // 0
+    OP_JGE_SIZE, 12,                                            // 3
+    OP_SET_I, OP_INC_I, OP_WAIT, 1, OP_YIELD, OP_JMP, 3,        // 5
+    OP_DONE                                                     // 12
+};
 
-    bits_effects_delay();
-    bits_effects_delay();
+//! Apaga os leds do primeiro para o último
+const uint8_t bits_effects_ramp_up_off[] PROGMEM = {
+    OP_FILL_ALL, OP_I_ZERO, OP_YIELD,                           // 0
+    OP_JGE_SIZE, 12,                                            // 3
+    OP_CLR_I, OP_INC_I, OP_WAIT, 1, OP_YIELD, OP_JMP, 3,        // 5
+    OP_DONE                                                     // 12
+};
 
-    if(i >= bits_effects.size){
-        effect_started = false;
-        bits_effects.effect_done = true;
-        return;
-    }
-}
+//! Acende os leds do último para o primeiro
+const uint8_t bits_effects_ramp_down_on[] PROGMEM = {
+    OP_FILL_ZERO, OP_I_SIZE, OP_YIELD,                          // 0
+    OP_DEC_I, OP_SET_I, OP_WAIT, 1, OP_JZ_I, 12, OP_YIELD,      // 3
+    OP_JMP, 3,                                                  // 10
+    OP_DONE                                                     // 12
+};
 
-/**
- * @brief Pisca todos os leds
- * 
- */
-void bits_effects_flash(){
-    static bool effect_started = false;
+//! Apaga os leds do último para o primeiro
+const uint8_t bits_effects_ramp_down_off[] PROGMEM = {
+    OP_FILL_ALL, OP_I_SIZE, OP_YIELD,                           // 0
+    OP_DEC_I, OP_CLR_I, OP_WAIT, 1, OP_JZ_I, 12, OP_YIELD,      // 3
+    OP_JMP, 3,                                                  // 10
+    OP_DONE                                                     // 12
+};
 
-    if(!effect_started){
-        bits_effects.bits = all_on;
-        effect_started = true;
-        i = 0;
-        return;
-    }
+//! Inverte os leds do primeiro para o último
+const uint8_t bits_effects_flash_swap_up[] PROGMEM = {
+    OP_FILL_ALT, OP_I_ZERO, OP_YIELD,                           // 0
+    OP_SHL, OP_INC_I, OP_WAIT, 2, OP_JGE_SIZE, 12, OP_YIELD,    // 3
+    OP_JMP, 3,                                                  // 10
+    OP_DONE                                                     // 12
+};
 
-    if(i % 2 == 0) bits_effects.bits = all_on;
-    else bits_effects.bits = 0;
-    i++;
+//! Inverte os leds do último para o primeiro
+const uint8_t bits_effects_flash_swap_down[] PROGMEM = {
+    OP_FILL_ALT, OP_SHL, OP_I_ZERO, OP_YIELD,                   // 0
+    OP_SHR, OP_INC_I, OP_WAIT, 2, OP_JGE_SIZE, 13, OP_YIELD,    // 4
+    OP_JMP, 4,                                                  // 11
+    OP_DONE                                                     // 13
+};
 
-    bits_effects_delay();
-    bits_effects_delay();
+//! Inverte os leds mantendo a sequencia estática
+const uint8_t bits_effects_flash_swap[] PROGMEM = {
+    OP_FILL_ALT, OP_I_ZERO, OP_YIELD,                           // 0
+    OP_SWAP, OP_INC_I, OP_WAIT, 2, OP_JGE_SIZE, 12, OP_YIELD,   // 3
+    OP_JMP, 3,                                                  // 10
+    OP_DONE                                                     // 12
+};
 
-    if(i >= 16){
-        effect_started = false;
-        bits_effects.effect_done = true;
-        return;
-    }
-}
+//! Pisca todos os leds
+const uint8_t bits_effects_flash[] PROGMEM = {
+    OP_FILL_ALL, OP_I_ZERO, OP_YIELD,                           // 0
+    OP_BLINK, OP_INC_I, OP_WAIT, 2, OP_JGE_N, 16, 13, OP_YIELD, // 3
+    OP_JMP, 3,                                                  // 11
+    OP_DONE                                                     // 13
+};
 
 /**
- * @brief Lista de efeitos a serem executados na função bits_effects_all
+ * @brief Efeitos disponíveis, indexados pela lista de reprodução
  * 
  */
-void (*effects[])(void) = {
-    bits_effects_ramp_up_on,
-    bits_effects_ramp_up_off,
-    bits_effects_ramp_down_on,
-    bits_effects_ramp_down_off,
+const uint8_t *const bits_effects_programs[] PROGMEM = {
     bits_effects_ramp_up_on,
     bits_effects_ramp_up_off,
     bits_effects_ramp_down_on,
     bits_effects_ramp_down_off,
     bits_effects_flash_swap_up,
     bits_effects_flash_swap_down,
-    bits_effects_flash_swap_up,
-    bits_effects_flash_swap_down,
     bits_effects_flash_swap,
-    bits_effects_flash_swap,
-    bits_effects_flash_swap,
-    bits_effects_flash_swap,
-    bits_effects_flash,
     bits_effects_flash,
 };
 
+/**
+ * @brief Lista de efeitos a serem executados na função bits_effects_all
+ * 
+ */
+const uint8_t bits_effects_playlist[EFFECTS_COUNT] PROGMEM = {
+    0, 1, 2, 3,
+    0, 1, 2, 3,
+    4, 5, 4, 5,
+    6, 6, 6, 6,
+    7, 7,
+};
+
 /**
  * Funções Públicas
  */
 
 /**
- * @brief Inicializa a biblioteca bits_effects
+ * @brief Inicializa um contexto de efeitos
  * 
- * @param effects_cfg Estrutura de dados com as configurações dos efeitos
+ * @param effects Contexto dos efeitos
+ * @param size Quantidade de bits até FRAME_MAX_BITS, a serem utilizados para os efeitos
+ * @param speed Velocidade dos efeitos (0 a 100)
  */
-void bits_effects_init(bits_effects_t effects_cfg){
-    bits_effects.size = effects_cfg.size;
-    bits_effects.speed = effects_cfg.speed;
-    bits_effects.bits = 0;
-    bits_effects.effect_done = false;
-    bits_effects.effects_done = false;
-    bits_effects.selected_effect = 0;
-    time = map(bits_effects.speed, 0, 100, DEFAULT_MAX_DELAY, DEFAULT_MIN_DELAY);
-    all_on = pow(2, bits_effects.size) - 1;
-    i = 0;
+void bits_effects_init(bits_effects_t *effects, uint8_t size, uint8_t speed){
+    effects->size = size;
+    effects->speed = speed;
+    bits_frame_clear(&effects->bits);
+    effects->effect_done = false;
+    effects->effects_done = false;
+    effects->selected_effect = 0;
+    effects->time = map(effects->speed, 0, 100, DEFAULT_MAX_DELAY, DEFAULT_MIN_DELAY);
+    bits_frame_fill(&effects->all_on, effects->size);
+    effects->i = 0;
+    effects->pc = 0;
+    soft_timer_stop(&effects->timer);
 }
 
 /**
  * @brief Executa todos os efeitos programados na lista de efeitos
  * 
- * @return true Assim que a lista de efeitos é concluída
- * @return false Enquanto a lista de efeitos estiver sendo processada
+ * @note Não bloqueia: enquanto o prazo do passo atual não expira, apenas retorna
+ * 
+ * @param effects Contexto dos efeitos
+ * @return true Na primeira chamada após o fim de um efeito da lista (a cada efeito, não apenas ao fim da lista)
+ * @return false Enquanto o efeito atual estiver em andamento
  */
-bool bits_effects_all(){
-    bits_effects.selected_effect += bits_effects.effect_done ? 1 : 0;
-    bits_effects.effects_done = bits_effects.selected_effect >= EFFECTS_COUNT;
-    bits_effects.selected_effect = bits_effects.effects_done ? 0 : bits_effects.selected_effect;
-    bool ret = bits_effects.effect_done;
-    bits_effects.effect_done = false;
+bool bits_effects_all(bits_effects_t *effects){
+    if(!soft_timer_expired(&effects->timer)) return false;
+
+    effects->selected_effect += effects->effect_done ? 1 : 0;
+    effects->effects_done = effects->selected_effect >= EFFECTS_COUNT;
+    effects->selected_effect = effects->effects_done ? 0 : effects->selected_effect;
+    bool ret = effects->effect_done;
+    effects->effect_done = false;
 
-    effects[bits_effects.selected_effect]();
+    uint8_t effect = pgm_read_byte(&bits_effects_playlist[effects->selected_effect]);
+    bits_effects_run(effects, (const uint8_t *)pgm_read_ptr(&bits_effects_programs[effect]));
 
-    bits_effects.effects_done = false;
+    effects->effects_done = false;
     return ret;
 }
 
 /**
- * @brief Reinicia a seleção dos efeitos
+ * @brief Reinicia a seleção dos efeitos, voltando ao início do primeiro efeito
  * 
+ * @param effects Contexto dos efeitos
  */
-void bits_effects_reset(){
-    bits_effects.selected_effect = 0;
-    bits_effects.bits = 0;
-    bits_effects.effect_done = false;
-    bits_effects.effects_done = false;
-    i = 0;
+void bits_effects_reset(bits_effects_t *effects){
+    effects->selected_effect = 0;
+    bits_frame_clear(&effects->bits);
+    effects->effect_done = false;
+    effects->effects_done = false;
+    effects->i = 0;
+    effects->pc = 0;
+    soft_timer_stop(&effects->timer);
 }
 
 /**
- * @brief Obtém os valores dos 32 bits processados pela biblioteca
+ * @brief Obtém o quadro de bits processado pela biblioteca
  * 
- * @return uint32_t variável contendo os 32 bits processados
+ * @param effects Contexto dos efeitos
+ * @return const bits_frame_t* quadro contendo os bits processados
  */
-uint32_t bits_effects_get_bits(){
-    return bits_effects.bits;
+const bits_frame_t *bits_effects_get_bits(const bits_effects_t *effects){
+    return &effects->bits;
+}
+
+/**
+ * @brief Obtém o instante em que bits_effects_all precisa ser chamada novamente
+ * 
+ * @param effects Contexto dos efeitos
+ * @return uint32_t Instante (millis) do próximo passo do efeito
+ */
+uint32_t bits_effects_deadline(const bits_effects_t *effects){
+    return soft_timer_deadline(&effects->timer);
 }
 
 /**
  * @brief Testa a biblioteca escrevendo a saída do processamento no serial monitor
  * 
+ * @param effects Contexto dos efeitos, já inicializado
  */
-void bits_effects_test(){
+void bits_effects_test(bits_effects_t *effects){
     Serial.begin(9600);
 
     while (1)
     {
-        bits_effects_all();
-        bits_effects_print_bits();
+        bits_effects_all(effects);
+        bits_effects_print_bits(effects);
     }
     
 }
@@ -350,24 +223,110 @@ void bits_effects_test(){
  */
 
 /**
- * @brief Aguarda o tempo calculado com base na velocidade do efeito, e nas constantes de delay (DEFAULT_MAX_DELAY, DEFAULT_MIN_DELAY)
+ * @brief Executa um passo do efeito: interpreta as instruções até OP_YIELD ou OP_DONE
  * 
+ * @param effects Contexto dos efeitos
+ * @param program Programa do efeito, na memória de programa
  */
-void bits_effects_delay(){
-    delay(time);
+void bits_effects_run(bits_effects_t *effects, const uint8_t *program){
+    while (1)
+    {
+        uint8_t op = pgm_read_byte(&program[effects->pc++]);
+
+        switch (op)
+        {
+        case OP_FILL_ZERO:
+            bits_frame_clear(&effects->bits);
+            break;
+        case OP_FILL_ALL:
+            effects->bits = effects->all_on;
+            break;
+        case OP_FILL_ALT:
+            bits_frame_fill_alternate(&effects->bits, effects->size);
+            break;
+        case OP_I_ZERO:
+            effects->i = 0;
+            break;
+        case OP_I_SIZE:
+            effects->i = effects->size;
+            break;
+        case OP_SET_I:
+            bits_frame_set(&effects->bits, effects->i);
+            break;
+        case OP_CLR_I:
+            bits_frame_reset(&effects->bits, effects->i);
+            break;
+        case OP_INC_I:
+            effects->i++;
+            break;
+        case OP_DEC_I:
+            effects->i--;
+            break;
+        case OP_SHL:
+            bits_frame_shift_left(&effects->bits);
+            break;
+        case OP_SHR:
+            bits_frame_shift_right(&effects->bits);
+            break;
+        case OP_SWAP:
+            if(effects->i % 2 == 0) bits_frame_shift_left(&effects->bits);
+            else bits_frame_shift_right(&effects->bits);
+            break;
+        case OP_BLINK:
+            if(effects->i % 2 == 0) effects->bits = effects->all_on;
+            else bits_frame_clear(&effects->bits);
+            break;
+        case OP_WAIT:
+            bits_effects_delay(effects, pgm_read_byte(&program[effects->pc++]));
+            break;
+        case OP_YIELD:
+            return;
+        case OP_JMP:
+            effects->pc = pgm_read_byte(&program[effects->pc]);
+            break;
+        case OP_JGE_SIZE:
+            effects->pc = effects->i >= effects->size ? pgm_read_byte(&program[effects->pc]) : effects->pc + 1;
+            break;
+        case OP_JGE_N:
+            effects->pc = effects->i >= pgm_read_byte(&program[effects->pc]) ? pgm_read_byte(&program[effects->pc + 1]) : effects->pc + 2;
+            break;
+        case OP_JZ_I:
+            effects->pc = effects->i == 0 ? pgm_read_byte(&program[effects->pc]) : effects->pc + 1;
+            break;
+        default:
+            effects->pc = 0;
+            effects->effect_done = true;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Agenda o próximo passo do efeito com base na velocidade do efeito, e nas constantes de delay (DEFAULT_MAX_DELAY, DEFAULT_MIN_DELAY)
+ * 
+ * @param effects Contexto dos efeitos
+ * @param periods Quantidade de períodos até o próximo passo
+ */
+void bits_effects_delay(bits_effects_t *effects, uint8_t periods){
+    soft_timer_next(&effects->timer, effects->time * periods);
 }
 
 /**
  * @brief Imprime a saída do processamento da biblioteca no serial monitor
  * 
+ * @param effects Contexto dos efeitos
  */
-void bits_effects_print_bits(){
-    Serial.print(bits_effects.bits);
+void bits_effects_print_bits(const bits_effects_t *effects){
+    for (uint8_t w = FRAME_WORDS; w > 0; w--)
+    {
+        Serial.print(effects->bits.words[w - 1]);
+        if(w > 1) Serial.print(':');
+    }
     Serial.print('\t');
 
-    for (size_t i = 0; i < bits_effects.size; i++)
+    for (size_t i = 0; i < effects->size; i++)
     {
-        Serial.print(bitRead(bits_effects.bits, i));
+        Serial.print(bits_frame_get(&effects->bits, i) ? '1' : '0');
     }
     Serial.println();
 }
\ No newline at end of file
@@ -12,30 +12,69 @@
 #ifndef __BITSEFFECTS__H__
 #define __BITSEFFECTS__H__
 
-#include <Arduino.h>
+#include "hal.h"
+#include "soft_timer.h"
+#include "bits_frame.h"
 
 #define DEFAULT_MAX_DELAY 150
 #define DEFAULT_MIN_DELAY 30
-#define EFFECTS_COUNT 18
+#define EFFECTS_COUNT 18             //!< Tamanho da lista de reprodução dos efeitos
 
 /**
- * @brief Estrutura de dados para controlar os efeitos
+ * @brief Instruções dos programas de efeito
+ * 
+ * Cada passo do efeito executa instruções até OP_YIELD (o passo termina e o
+ * próximo começa no prazo armado por OP_WAIT) ou OP_DONE (efeito concluído).
+ * Os destinos dos saltos são posições dentro do próprio programa.
+ */
+typedef enum
+{
+    OP_DONE,                        //!< Conclui o efeito
+    OP_FILL_ZERO,                   //!< Apaga todos os bits
+    OP_FILL_ALL,                    //!< Acende todos os bits
+    OP_FILL_ALT,                    //!< Acende bits alternados
+    OP_I_ZERO,                      //!< i = 0
+    OP_I_SIZE,                      //!< i = quantidade de bits
+    OP_SET_I,                       //!< Acende o bit i
+    OP_CLR_I,                       //!< Apaga o bit i
+    OP_INC_I,                       //!< i++
+    OP_DEC_I,                       //!< i--
+    OP_SHL,                         //!< Desloca o quadro em direção ao último bit
+    OP_SHR,                         //!< Desloca o quadro em direção ao primeiro bit
+    OP_SWAP,                        //!< OP_SHL se i for par, OP_SHR se for ímpar
+    OP_BLINK,                       //!< Acende todos os bits se i for par, apaga se for ímpar
+    OP_WAIT,                        //!< [n] Agenda o próximo passo para daqui a n períodos (não encerra o passo)
+    OP_YIELD,                       //!< Encerra o passo
+    OP_JMP,                         //!< [destino] Salta
+    OP_JGE_SIZE,                    //!< [destino] Salta se i >= quantidade de bits
+    OP_JGE_N,                       //!< [n, destino] Salta se i >= n
+    OP_JZ_I                         //!< [destino] Salta se i == 0
+}bits_effects_op_t;
+
+/**
+ * @brief Contexto de um motor de efeitos. Cada roleta ou zona de leds possui o seu
  * 
  */
 typedef struct
 {
-    uint8_t size;                   //!< Quantidade de bits até 32, a serem utilizados para os efeitos
+    uint8_t size;                   //!< Quantidade de bits até FRAME_MAX_BITS, a serem utilizados para os efeitos
     uint8_t speed;                  //!< Velocidade dos efeitos
-    uint32_t bits;                  //!< Variável para controlar o efeito de 32 bits
+    bits_frame_t bits;              //!< Quadro para controlar o efeito
     bool effect_done;               //!< Efeito concluído
     bool effects_done;              //!< Todos os efeitos concluídos
     uint8_t selected_effect;        //!< Efeito selecionado
+    uint8_t i;                      //!< Índice auxiliar para controlar os efeitos
+    uint8_t pc;                     //!< Posição da próxima instrução do efeito selecionado (0 = efeito não iniciado)
+    uint32_t time;                  //!< Tempo calculado com base na velocidade do efeito, e as constantes de delay (DEFAULT_MAX_DELAY, DEFAULT_MIN_DELAY)
+    bits_frame_t all_on;            //!< Estado calculado que permite acionar todos os bits da cadeia de bits configurada
+    soft_timer_t timer;             //!< Temporizador que controla o prazo do próximo passo do efeito
 }bits_effects_t;
 
-void bits_effects_init(bits_effects_t effects_cfg);
-bool bits_effects_all();
-void bits_effects_reset();
-uint32_t bits_effects_get_bits();
-void bits_effects_test();
+void bits_effects_init(bits_effects_t *effects, uint8_t size, uint8_t speed);
+bool bits_effects_all(bits_effects_t *effects);
+void bits_effects_reset(bits_effects_t *effects);
+const bits_frame_t *bits_effects_get_bits(const bits_effects_t *effects);
+uint32_t bits_effects_deadline(const bits_effects_t *effects);
+void bits_effects_test(bits_effects_t *effects);
 
 #endif  //!__BITSEFFECTS__H__
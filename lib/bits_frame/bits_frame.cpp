@@ -0,0 +1,215 @@
+/**
+ * @file bits_frame.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Quadro de bits com tamanho definido em tempo de compilação, para cadeias com mais de 32 leds
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "bits_frame.h"
+
+/**
+ * Protótipos das funções privadas
+ */
+void bits_frame_fill_pattern(bits_frame_t *frame, uint32_t pattern, uint16_t size);
+
+/**
+ * Funções Públicas
+ */
+
+/**
+ * @brief Apaga todos os bits do quadro
+ * 
+ * @param frame Quadro
+ */
+void bits_frame_clear(bits_frame_t *frame){
+    for (uint8_t w = 0; w < FRAME_WORDS; w++)
+    {
+        frame->words[w] = 0;
+    }
+}
+
+/**
+ * @brief Acende os primeiros size bits do quadro e apaga os demais (equivalente a 2^size - 1)
+ * 
+ * @param frame Quadro
+ * @param size Quantidade de bits acesos
+ */
+void bits_frame_fill(bits_frame_t *frame, uint16_t size){
+    bits_frame_fill_pattern(frame, 0xFFFFFFFF, size);
+}
+
+/**
+ * @brief Acende bits alternados, terminando no bit size - 2 (equivalente a (2^size - 1) / 3)
+ * 
+ * @param frame Quadro
+ * @param size Quantidade de bits da cadeia
+ */
+void bits_frame_fill_alternate(bits_frame_t *frame, uint16_t size){
+    if(size == 0){
+        bits_frame_clear(frame);
+        return;
+    }
+    bits_frame_fill_pattern(frame, size % 2 == 0 ? 0x55555555 : 0xAAAAAAAA, size - 1);
+}
+
+/**
+ * @brief Acende um bit do quadro
+ * 
+ * @param frame Quadro
+ * @param bit Posição do bit
+ */
+void bits_frame_set(bits_frame_t *frame, uint16_t bit){
+    if(bit >= FRAME_WORDS * FRAME_WORD_BITS) return;
+    frame->words[bit / FRAME_WORD_BITS] |= (uint32_t)1 << (bit % FRAME_WORD_BITS);
+}
+
+/**
+ * @brief Apaga um bit do quadro
+ * 
+ * @param frame Quadro
+ * @param bit Posição do bit
+ */
+void bits_frame_reset(bits_frame_t *frame, uint16_t bit){
+    if(bit >= FRAME_WORDS * FRAME_WORD_BITS) return;
+    frame->words[bit / FRAME_WORD_BITS] &= ~((uint32_t)1 << (bit % FRAME_WORD_BITS));
+}
+
+/**
+ * @brief Lê um bit do quadro
+ * 
+ * @param frame Quadro
+ * @param bit Posição do bit
+ * @return true Se o bit está aceso
+ */
+bool bits_frame_get(const bits_frame_t *frame, uint16_t bit){
+    if(bit >= FRAME_WORDS * FRAME_WORD_BITS) return false;
+    return (frame->words[bit / FRAME_WORD_BITS] >> (bit % FRAME_WORD_BITS)) & 0x01;
+}
+
+/**
+ * @brief Lê 8 bits consecutivos do quadro
+ * 
+ * @param frame Quadro
+ * @param first Posição do primeiro bit (bit 0 do resultado)
+ * @return uint8_t Bits lidos. Bits além do fim do quadro são lidos como 0
+ */
+uint8_t bits_frame_get_byte(const bits_frame_t *frame, uint16_t first){
+    uint16_t word = first / FRAME_WORD_BITS;
+    uint8_t offset = first % FRAME_WORD_BITS;
+
+    if(word >= FRAME_WORDS) return 0;
+
+    uint32_t value = frame->words[word] >> offset;
+    if(offset > FRAME_WORD_BITS - 8 && word + 1 < FRAME_WORDS){
+        value |= frame->words[word + 1] << (FRAME_WORD_BITS - offset);
+    }
+    return (uint8_t)value;
+}
+
+/**
+ * @brief Desloca o quadro um bit para cima (em direção ao último led), palavra a palavra
+ * 
+ * @param frame Quadro
+ */
+void bits_frame_shift_left(bits_frame_t *frame){
+    for (uint8_t w = FRAME_WORDS - 1; w > 0; w--)
+    {
+        frame->words[w] = (frame->words[w] << 1) | (frame->words[w - 1] >> (FRAME_WORD_BITS - 1));
+    }
+    frame->words[0] <<= 1;
+}
+
+/**
+ * @brief Desloca o quadro um bit para baixo (em direção ao primeiro led), palavra a palavra
+ * 
+ * @param frame Quadro
+ */
+void bits_frame_shift_right(bits_frame_t *frame){
+    for (uint8_t w = 0; w < FRAME_WORDS - 1; w++)
+    {
+        frame->words[w] = (frame->words[w] >> 1) | (frame->words[w + 1] << (FRAME_WORD_BITS - 1));
+    }
+    frame->words[FRAME_WORDS - 1] >>= 1;
+}
+
+/**
+ * @brief Aplica uma máscara ao quadro
+ * 
+ * @param frame Quadro
+ * @param mask Máscara
+ */
+void bits_frame_and(bits_frame_t *frame, const bits_frame_t *mask){
+    for (uint8_t w = 0; w < FRAME_WORDS; w++)
+    {
+        frame->words[w] &= mask->words[w];
+    }
+}
+
+/**
+ * @brief Calcula os bits diferentes entre dois quadros
+ * 
+ * @param result Quadro com os bits diferentes
+ * @param a Primeiro quadro
+ * @param b Segundo quadro
+ */
+void bits_frame_xor(bits_frame_t *result, const bits_frame_t *a, const bits_frame_t *b){
+    for (uint8_t w = 0; w < FRAME_WORDS; w++)
+    {
+        result->words[w] = a->words[w] ^ b->words[w];
+    }
+}
+
+/**
+ * @brief Compara dois quadros
+ * 
+ * @param a Primeiro quadro
+ * @param b Segundo quadro
+ * @return true Se os quadros são iguais
+ */
+bool bits_frame_equal(const bits_frame_t *a, const bits_frame_t *b){
+    for (uint8_t w = 0; w < FRAME_WORDS; w++)
+    {
+        if(a->words[w] != b->words[w]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Verifica se todos os bits do quadro estão apagados
+ * 
+ * @param frame Quadro
+ * @return true Se nenhum bit está aceso
+ */
+bool bits_frame_is_zero(const bits_frame_t *frame){
+    for (uint8_t w = 0; w < FRAME_WORDS; w++)
+    {
+        if(frame->words[w]) return false;
+    }
+    return true;
+}
+
+/**
+ * Funções privadas
+ */
+
+/**
+ * @brief Preenche os primeiros size bits do quadro com um padrão de 32 bits, e apaga os demais
+ * 
+ * @param frame Quadro
+ * @param pattern Padrão repetido em todas as palavras
+ * @param size Quantidade de bits preenchidos
+ */
+void bits_frame_fill_pattern(bits_frame_t *frame, uint32_t pattern, uint16_t size){
+    for (uint8_t w = 0; w < FRAME_WORDS; w++)
+    {
+        uint16_t first = w * FRAME_WORD_BITS;
+
+        if(size >= first + FRAME_WORD_BITS) frame->words[w] = pattern;
+        else if(size > first) frame->words[w] = pattern & (((uint32_t)1 << (size - first)) - 1);
+        else frame->words[w] = 0;
+    }
+}
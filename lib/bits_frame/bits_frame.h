@@ -0,0 +1,47 @@
+/**
+ * @file bits_frame.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Quadro de bits com tamanho definido em tempo de compilação, para cadeias com mais de 32 leds
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __BITSFRAME__H__
+#define __BITSFRAME__H__
+
+#include "hal.h"
+
+#ifndef FRAME_MAX_BITS
+#define FRAME_MAX_BITS 32               //!< Quantidade máxima de bits (leds) do quadro. Ex.: -DFRAME_MAX_BITS=64 para roletas de 37 ou 38 casas
+#endif
+
+#define FRAME_WORD_BITS 32                                              //!< Quantidade de bits de cada palavra do quadro
+#define FRAME_WORDS ((FRAME_MAX_BITS + FRAME_WORD_BITS - 1) / FRAME_WORD_BITS)     //!< Quantidade de palavras do quadro
+
+/**
+ * @brief Quadro de bits, armazenado em palavras de 32 bits (bit 0 = bit 0 da primeira palavra)
+ * 
+ */
+typedef struct
+{
+    uint32_t words[FRAME_WORDS];    //!< Palavras do quadro
+}bits_frame_t;
+
+void bits_frame_clear(bits_frame_t *frame);
+void bits_frame_fill(bits_frame_t *frame, uint16_t size);
+void bits_frame_fill_alternate(bits_frame_t *frame, uint16_t size);
+void bits_frame_set(bits_frame_t *frame, uint16_t bit);
+void bits_frame_reset(bits_frame_t *frame, uint16_t bit);
+bool bits_frame_get(const bits_frame_t *frame, uint16_t bit);
+uint8_t bits_frame_get_byte(const bits_frame_t *frame, uint16_t first);
+void bits_frame_shift_left(bits_frame_t *frame);
+void bits_frame_shift_right(bits_frame_t *frame);
+void bits_frame_and(bits_frame_t *frame, const bits_frame_t *mask);
+void bits_frame_xor(bits_frame_t *result, const bits_frame_t *a, const bits_frame_t *b);
+bool bits_frame_equal(const bits_frame_t *a, const bits_frame_t *b);
+bool bits_frame_is_zero(const bits_frame_t *frame);
+
+#endif  //!__BITSFRAME__H__
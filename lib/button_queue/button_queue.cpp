@@ -0,0 +1,81 @@
+/**
+ * @file button_queue.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fila sem bloqueio de eventos de botão, da interrupção para o loop principal
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "button_queue.h"
+
+/**
+ * Funções Públicas
+ */
+
+/**
+ * @brief Inicializa a fila vazia. Não deve ser chamada com o produtor ativo
+ * 
+ * @param queue Fila
+ */
+void button_queue_init(button_queue_t *queue){
+    queue->head = 0;
+    queue->tail = 0;
+    queue->overflows = 0;
+}
+
+/**
+ * @brief Adiciona um evento à fila. Chamada apenas pelo produtor (interrupção)
+ * 
+ * @param queue Fila
+ * @param button Botão pressionado
+ * @param time Instante (millis) do pressionamento
+ * @return true Se o evento foi adicionado
+ * @return false Se a fila estava cheia (o evento é descartado e contado em overflows)
+ */
+bool button_queue_push(button_queue_t *queue, uint8_t button, uint32_t time){
+    uint8_t head = queue->head;
+    uint8_t next = (head + 1) & (BUTTON_QUEUE_SIZE - 1);
+
+    if(next == queue->tail){
+        queue->overflows++;
+        return false;
+    }
+
+    queue->events[head].button = button;
+    queue->events[head].time = time;
+    hal_memory_barrier();
+    queue->head = next;
+    return true;
+}
+
+/**
+ * @brief Retira o evento mais antigo da fila. Chamada apenas pelo consumidor (loop principal)
+ * 
+ * @param queue Fila
+ * @param event Destino do evento
+ * @return true Se havia um evento
+ */
+bool button_queue_pop(button_queue_t *queue, button_event_t *event){
+    uint8_t tail = queue->tail;
+
+    if(tail == queue->head) return false;
+
+    hal_memory_barrier();
+    *event = queue->events[tail];
+    hal_memory_barrier();
+    queue->tail = (tail + 1) & (BUTTON_QUEUE_SIZE - 1);
+    return true;
+}
+
+/**
+ * @brief Verifica se a fila está vazia
+ * 
+ * @param queue Fila
+ * @return true Se não há eventos
+ */
+bool button_queue_empty(const button_queue_t *queue){
+    return queue->head == queue->tail;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file button_queue.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Fila sem bloqueio de eventos de botão, da interrupção para o loop principal
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Fila circular de um produtor (rotinas de interrupção, que não se
+ * aninham) e um consumidor (loop principal). Os índices têm 8 bits, então
+ * cada leitura e escrita é atômica no AVR e nenhum dos lados precisa
+ * desabilitar as interrupções.
+ * 
+ */
+
+#ifndef __BUTTONQUEUE__H__
+#define __BUTTONQUEUE__H__
+
+#include "hal.h"
+
+#define BUTTON_QUEUE_SIZE 8             //!< Capacidade da fila (potência de 2). Uma posição fica sempre livre
+
+/**
+ * @brief Evento de botão
+ */
+typedef struct
+{
+    uint8_t button;                     //!< Botão pressionado
+    uint32_t time;                      //!< Instante (millis) do pressionamento
+}button_event_t;
+
+/**
+ * @brief Fila de eventos de botão
+ */
+typedef struct
+{
+    button_event_t events[BUTTON_QUEUE_SIZE];   //!< Eventos
+    volatile uint8_t head;                      //!< Próxima posição a ser escrita (somente o produtor altera)
+    volatile uint8_t tail;                      //!< Próxima posição a ser lida (somente o consumidor altera)
+    volatile uint8_t overflows;                 //!< Eventos descartados com a fila cheia
+}button_queue_t;
+
+void button_queue_init(button_queue_t *queue);
+bool button_queue_push(button_queue_t *queue, uint8_t button, uint32_t time);
+bool button_queue_pop(button_queue_t *queue, button_event_t *event);
+bool button_queue_empty(const button_queue_t *queue);
+
+#endif  //!__BUTTONQUEUE__H__
@@ -0,0 +1,66 @@
+/**
+ * @file fast_random.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Gerador pseudoaleatório xorshift32, com sorteio sem viés em um intervalo
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "fast_random.h"
+
+/**
+ * Funções Públicas
+ */
+
+/**
+ * @brief Define a semente do gerador
+ * 
+ * @param random Gerador
+ * @param seed Semente (0 é substituído por FAST_RANDOM_DEFAULT_SEED)
+ */
+void fast_random_seed(fast_random_t *random, uint32_t seed){
+    random->state = seed ? seed : FAST_RANDOM_DEFAULT_SEED;
+}
+
+/**
+ * @brief Gera o próximo número (xorshift32 de Marsaglia, período 2^32 - 1)
+ * 
+ * @param random Gerador
+ * @return uint32_t Número entre 1 e 0xFFFFFFFF
+ */
+uint32_t fast_random_next(fast_random_t *random){
+    uint32_t x = random->state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    random->state = x;
+    return x;
+}
+
+/**
+ * @brief Sorteia um número entre 0 e bound - 1, com a mesma probabilidade para todos
+ * 
+ * @param random Gerador
+ * @param bound Limite superior (exclusivo)
+ * @return uint8_t Número sorteado (0 se bound for 0)
+ */
+uint8_t fast_random_below(fast_random_t *random, uint8_t bound){
+    if(bound == 0) return 0;
+
+    uint32_t product = (uint32_t)(uint16_t)(fast_random_next(random) >> 16) * bound;
+    uint16_t low = product;
+
+    if(low < bound){
+        uint16_t threshold = (uint16_t)(0x10000UL - bound) % bound;
+        while (low < threshold)
+        {
+            product = (uint32_t)(uint16_t)(fast_random_next(random) >> 16) * bound;
+            low = product;
+        }
+    }
+    return product >> 16;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file fast_random.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Gerador pseudoaleatório xorshift32, com sorteio sem viés em um intervalo
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * O random() do Arduino usa um gerador congruente com divisões de 32 bits,
+ * que no AVR custam centenas de ciclos cada, e random(n) % n favorece os
+ * menores valores. O xorshift32 usa apenas deslocamentos e XOR, e
+ * fast_random_below() reduz o número ao intervalo com uma multiplicação
+ * 16 x 8 bits, rejeitando os poucos valores que causariam viés (método de
+ * Lemire). A divisão só acontece nesse caso raro.
+ * 
+ */
+
+#ifndef __FAST_RANDOM__H__
+#define __FAST_RANDOM__H__
+
+#include "hal.h"
+
+#define FAST_RANDOM_DEFAULT_SEED 2463534242UL   //!< Semente utilizada no lugar de 0, que o xorshift não aceita
+
+/**
+ * @brief Estado do gerador
+ */
+typedef struct
+{
+    uint32_t state;                     //!< Estado do xorshift32 (nunca 0)
+}fast_random_t;
+
+void fast_random_seed(fast_random_t *random, uint32_t seed);
+uint32_t fast_random_next(fast_random_t *random);
+uint8_t fast_random_below(fast_random_t *random, uint8_t bound);
+
+#endif  //!__FAST_RANDOM__H__
@@ -0,0 +1,125 @@
+/**
+ * @file hal.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Camada de abstração de hardware utilizada pelas bibliotecas da roleta
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * No Arduino a camada simplesmente inclui o framework. Nos demais ambientes
+ * (env:native) é utilizado um shim com a mesma API do Arduino, executado
+ * sobre um relógio virtual.
+ * 
+ */
+
+#ifndef __HAL__H__
+#define __HAL__H__
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include "hal_native.h"
+#endif
+
+#ifndef HAL_THREAD_LOCAL
+#define HAL_THREAD_LOCAL                //!< Estado global único. No computador, com HAL_THREADS, cada thread tem a sua cópia
+#endif
+
+#if defined(__AVR__) || defined(HAL_NATIVE)
+#define HAL_HAS_PORTS 1                 //!< Os pinos podem ser escritos diretamente nos registradores PORTx de 8 bits
+#endif
+
+#if defined(__AVR_ATmega328P__) || defined(HAL_NATIVE)
+#define HAL_UNO_PIN_MAP 1               //!< O mapa de pinos do Arduino Uno é conhecido em tempo de compilação
+#endif
+
+/**
+ * Funções comuns a todos os ambientes
+ */
+
+void hal_wake();
+void hal_sleep_until(uint32_t deadline);
+uint64_t hal_sleep_us();
+uint32_t hal_entropy();
+bool hal_timer_start(uint32_t periodUs, void (*isr)(void));
+void hal_timer_stop();
+uint32_t hal_timer_cycles();
+
+/**
+ * @brief Barreira de compilação: impede o compilador de mover acessos à memória através deste ponto
+ * @note Utilizada entre a escrita de dados compartilhados com interrupções e a publicação do aviso de dados prontos
+ * 
+ */
+inline void hal_memory_barrier(){
+    __asm__ __volatile__("" ::: "memory");
+}
+
+#ifdef HAL_HAS_PORTS
+/**
+ * @brief Escreve os bits de uma máscara em um registrador de porta, sem alterar os demais bits
+ * @note A leitura-modificação-escrita é atômica, pois rotinas de interrupção (ex.: tone) também escrevem nas portas
+ * 
+ * @param out Registrador PORTx
+ * @param mask Bits a serem escritos
+ * @param value Novo valor dos bits da máscara
+ */
+inline void hal_port_write(volatile uint8_t *out, uint8_t mask, uint8_t value){
+#ifdef __AVR__
+    uint8_t oldSREG = SREG;
+    cli();
+    *out = (*out & ~mask) | value;
+    SREG = oldSREG;
+#else
+    *out = (*out & ~mask) | value;
+#endif
+}
+#endif
+
+#ifdef HAL_UNO_PIN_MAP
+/**
+ * @brief Obtém a porta de um pino do Arduino Uno em tempo de compilação
+ * 
+ * @param pin Pino digital (0 a 19)
+ * @return constexpr uint8_t PD, PB ou PC
+ */
+constexpr uint8_t hal_uno_pin_port(uint8_t pin){
+    return pin < 8 ? PD : (pin < 14 ? PB : PC);
+}
+
+/**
+ * @brief Obtém o primeiro pino do Arduino Uno ligado a uma porta
+ * 
+ * @param port PD, PB ou PC
+ * @return constexpr uint8_t Pino ligado ao bit 0 da porta
+ */
+constexpr uint8_t hal_uno_port_first_pin(uint8_t port){
+    return port == PD ? 0 : (port == PB ? 8 : 14);
+}
+
+/**
+ * @brief Obtém o último pino do Arduino Uno ligado a uma porta
+ * 
+ * @param port PD, PB ou PC
+ * @return constexpr uint8_t Último pino da porta
+ */
+constexpr uint8_t hal_uno_port_last_pin(uint8_t port){
+    return port == PD ? 7 : (port == PB ? 13 : 19);
+}
+
+/**
+ * @brief Obtém o registrador de saída de uma porta. Com a porta constante, vira um endereço fixo
+ * 
+ * @param port PD, PB ou PC
+ * @return volatile uint8_t* Registrador PORTx
+ */
+inline volatile uint8_t *hal_port_register(uint8_t port){
+#ifdef __AVR__
+    return port == PD ? &PORTD : (port == PB ? &PORTB : &PORTC);
+#else
+    return portOutputRegister(port);
+#endif
+}
+#endif
+
+#endif  //!__HAL__H__
@@ -0,0 +1,178 @@
+/**
+ * @file hal_arduino.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Implementação da camada de abstração de hardware para as placas Arduino
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifdef ARDUINO
+
+#include "hal.h"
+
+#ifdef __AVR__
+#include <avr/sleep.h>
+#endif
+
+#ifndef HAL_ENTROPY_PIN
+#define HAL_ENTROPY_PIN A0              //!< Entrada analógica desconectada, cujo ruído é utilizado como fonte de entropia
+#endif
+#define HAL_ENTROPY_SAMPLES 32          //!< Quantidade de leituras combinadas por hal_entropy()
+
+/**
+ * Variáveis globais
+ */
+volatile bool hal_wake_pending = false;         //!< Sinaliza que uma interrupção pediu para encerrar o sono
+uint64_t hal_slept = 0;                         //!< Tempo total dormindo, em microssegundos
+void (*volatile hal_timer_isr)(void) = NULL;    //!< Rotina do temporizador periódico
+uint16_t hal_timer_prescaler = 1;               //!< Divisor do clock do timer1 escolhido por hal_timer_start()
+
+#if defined(__AVR__) && defined(TCCR1A)
+/**
+ * @brief Interrupção de comparação do timer1 (modo CTC), que chama a rotina do temporizador periódico
+ * 
+ */
+ISR(TIMER1_COMPA_vect){
+    if(hal_timer_isr) hal_timer_isr();
+}
+#endif
+
+/**
+ * @brief Encerra o sono atual. Deve ser chamada pelas rotinas de interrupção que mudam o estado da aplicação
+ * 
+ */
+void hal_wake(){
+    hal_wake_pending = true;
+}
+
+/**
+ * @brief Dorme em modo idle até o prazo informado, até hal_wake() ser chamada ou até chegar um byte pela serial
+ * @note O timer0 (millis) continua acordando a CPU a cada 1,024 ms, o que permite conferir o prazo
+ * 
+ * @param deadline Instante (millis) em que a aplicação precisa ser atualizada
+ */
+void hal_sleep_until(uint32_t deadline){
+    uint32_t start = micros();
+
+    while ((int32_t)(millis() - deadline) < 0)
+    {
+#ifdef __AVR__
+        cli();
+        if(hal_wake_pending || Serial.available()){
+            sei();
+            break;
+        }
+        set_sleep_mode(SLEEP_MODE_IDLE);
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+#else
+        if(hal_wake_pending || Serial.available()) break;
+#endif
+    }
+
+    hal_wake_pending = false;
+    hal_slept += micros() - start;
+}
+
+/**
+ * @brief Inicia o temporizador periódico no timer1, em modo CTC
+ * @note O timer0 (millis) e o timer2 (tone) não são afetados
+ * 
+ * @param periodUs Período em microssegundos (até 4,19 s a 16 MHz)
+ * @param isr Rotina chamada a cada período, em contexto de interrupção
+ * @return true Se o temporizador foi iniciado
+ * @return false Se a placa não possui o timer1 ou o período está fora da faixa
+ */
+bool hal_timer_start(uint32_t periodUs, void (*isr)(void)){
+#if defined(__AVR__) && defined(TCCR1A)
+    static const uint16_t prescalers[] = {1, 8, 64, 256, 1024};
+    uint32_t cycles = (F_CPU / 1000000UL) * periodUs;
+
+    if(periodUs == 0 || isr == NULL) return false;
+
+    for (uint8_t p = 0; p < 5; p++)
+    {
+        uint32_t ticks = cycles / prescalers[p];
+        if(ticks == 0 || ticks > 65536UL) continue;
+
+        uint8_t oldSREG = SREG;
+        cli();
+        hal_timer_isr = isr;
+        TCCR1A = 0;
+        TCCR1B = 0;
+        TCNT1 = 0;
+        OCR1A = ticks - 1;
+        TCCR1B = _BV(WGM12) | (p + 1);
+        hal_timer_prescaler = prescalers[p];
+        TIFR1 = _BV(OCF1A);
+        TIMSK1 |= _BV(OCIE1A);
+        SREG = oldSREG;
+        return true;
+    }
+#endif
+    return false;
+}
+
+/**
+ * @brief Para o temporizador periódico
+ * 
+ */
+void hal_timer_stop(){
+#if defined(__AVR__) && defined(TCCR1A)
+    TIMSK1 &= ~_BV(OCIE1A);
+    TCCR1B = 0;
+#endif
+    hal_timer_isr = NULL;
+}
+
+/**
+ * @brief Obtém os ciclos da CPU desde o início do período atual do temporizador
+ * @note Chamada pela rotina do temporizador, mede o atraso real da interrupção (TCNT1 volta a 0 na comparação).
+ * A resolução é o divisor do timer1: 1 ciclo para períodos até 4,096 ms a 16 MHz
+ * 
+ * @return uint32_t Ciclos da CPU (0 se a placa não possui o timer1)
+ */
+uint32_t hal_timer_cycles(){
+#if defined(__AVR__) && defined(TCCR1A)
+    uint8_t oldSREG = SREG;
+    cli();
+    uint16_t ticks = TCNT1;
+    SREG = oldSREG;
+    return (uint32_t)ticks * hal_timer_prescaler;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Obtém uma semente para os geradores pseudoaleatórios
+ * @note Combina o bit menos significativo, ruidoso, das leituras de uma entrada analógica desconectada
+ * com a variação do tempo de conversão medida por micros(). Leva cerca de 4 ms
+ * 
+ * @return uint32_t Semente
+ */
+uint32_t hal_entropy(){
+    uint32_t entropy = 0;
+
+    for (uint8_t i = 0; i < HAL_ENTROPY_SAMPLES; i++)
+    {
+        entropy = (entropy << 7 | entropy >> 25) ^ analogRead(HAL_ENTROPY_PIN) ^ micros();
+    }
+    return entropy;
+}
+
+/**
+ * @brief Obtém o tempo total dormindo em hal_sleep_until()
+ * 
+ * @return uint64_t Tempo em microssegundos
+ */
+uint64_t hal_sleep_us(){
+    return hal_slept;
+}
+
+#endif  //!ARDUINO
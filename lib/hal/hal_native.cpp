@@ -0,0 +1,920 @@
+/**
+ * @file hal_native.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Shim da API do Arduino para execução no computador (env:native)
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef ARDUINO
+
+#include "hal.h"
+
+/**
+ * @brief Interrupção agendada no relógio virtual
+ */
+typedef struct
+{
+    uint64_t at;                    //!< Instante do disparo, em microssegundos
+    uint8_t interruptNum;           //!< Interrupção a ser disparada
+    bool pending;                   //!< Evento ainda não disparado
+}hal_event_t;
+
+/**
+ * Variáveis globais
+ */
+HAL_THREAD_LOCAL uint64_t hal_clock;                             //!< Relógio virtual em microssegundos
+HAL_THREAD_LOCAL uint8_t hal_pins_mode[HAL_PIN_COUNT];           //!< Modo configurado para cada pino
+HAL_THREAD_LOCAL volatile uint8_t hal_ports[HAL_PORT_COUNT];     //!< Registradores PORTx simulados, indexados pelo identificador da porta
+HAL_THREAD_LOCAL void (*hal_isrs[HAL_INTERRUPT_COUNT])(void);    //!< Rotinas de interrupção registradas
+HAL_THREAD_LOCAL hal_tone_t hal_tone;                            //!< Último tom solicitado
+HAL_THREAD_LOCAL unsigned long hal_random_next = 1;              //!< Estado do gerador pseudoaleatório (mesmo algoritmo da avr-libc)
+HAL_THREAD_LOCAL uint32_t hal_entropy_count;                     //!< Quantidade de chamadas a hal_entropy()
+HAL_THREAD_LOCAL hal_event_t hal_events[HAL_EVENT_COUNT];        //!< Interrupções agendadas
+HAL_THREAD_LOCAL bool hal_wake_pending;                          //!< Sinaliza que uma interrupção pediu para encerrar o sono
+HAL_THREAD_LOCAL uint64_t hal_slept;                             //!< Tempo total dormindo, em microssegundos
+HAL_THREAD_LOCAL void (*hal_timer_isr)(void);                    //!< Rotina do temporizador periódico (NULL = parado)
+HAL_THREAD_LOCAL uint32_t hal_timer_period;                      //!< Período do temporizador, em microssegundos
+HAL_THREAD_LOCAL uint64_t hal_timer_at;                          //!< Próximo disparo do temporizador, em microssegundos
+
+HAL_THREAD_LOCAL uint8_t hal_spi_chain[HAL_SPI_CHAIN];           //!< Registradores de deslocamento simulados (0 = ligado ao MOSI)
+HAL_THREAD_LOCAL uint32_t hal_spi_count;                         //!< Quantidade de bytes transferidos pelo SPI
+
+HAL_THREAD_LOCAL HalSerial Serial;                               //!< Instância global da serial simulada
+HAL_THREAD_LOCAL HalSPI SPI;                                     //!< Instância global do SPI simulado
+HAL_THREAD_LOCAL HalEeprom EEPROM;                               //!< Instância global da EEPROM simulada
+
+/**
+ * Funções de tempo
+ */
+
+/**
+ * @brief Obtém o tempo virtual decorrido em milissegundos
+ * 
+ * @return unsigned long Tempo em milissegundos
+ */
+unsigned long millis(){
+    return (unsigned long)(uint32_t)(hal_clock / 1000);
+}
+
+/**
+ * @brief Obtém o tempo virtual decorrido em microssegundos
+ * 
+ * @return unsigned long Tempo em microssegundos
+ */
+unsigned long micros(){
+    return (unsigned long)(uint32_t)hal_clock;
+}
+
+/**
+ * @brief Avança o relógio virtual instantaneamente
+ * 
+ * @param ms Tempo em milissegundos
+ */
+void delay(unsigned long ms){
+    hal_clock_advance(ms * 1000);
+}
+
+/**
+ * @brief Avança o relógio virtual instantaneamente
+ * 
+ * @param us Tempo em microssegundos
+ */
+void delayMicroseconds(unsigned int us){
+    hal_clock_advance(us);
+}
+
+/**
+ * Funções de entrada e saída
+ */
+
+/**
+ * @brief Configura o modo de um pino
+ * 
+ * @param pin Pino a ser configurado
+ * @param mode INPUT, OUTPUT ou INPUT_PULLUP
+ */
+void pinMode(uint8_t pin, uint8_t mode){
+    if(pin >= HAL_PIN_COUNT) return;
+    hal_pins_mode[pin] = mode;
+    if(mode == INPUT_PULLUP) digitalWrite(pin, HIGH);
+}
+
+/**
+ * @brief Escreve o estado de um pino
+ * 
+ * @param pin Pino a ser escrito
+ * @param val HIGH ou LOW
+ */
+void digitalWrite(uint8_t pin, uint8_t val){
+    if(pin >= HAL_PIN_COUNT) return;
+    volatile uint8_t *out = portOutputRegister(digitalPinToPort(pin));
+    uint8_t mask = digitalPinToBitMask(pin);
+    if(val) *out |= mask;
+    else *out &= ~mask;
+}
+
+/**
+ * @brief Lê o estado de um pino
+ * 
+ * @param pin Pino a ser lido
+ * @return int HIGH ou LOW
+ */
+int digitalRead(uint8_t pin){
+    return hal_pin_state(pin);
+}
+
+/**
+ * @brief Obtém a porta de um pino, com o mapa de pinos do Arduino Uno
+ * 
+ * @param pin Pino digital
+ * @return uint8_t PB, PC, PD ou NOT_A_PORT
+ */
+uint8_t digitalPinToPort(uint8_t pin){
+    if(pin < 8) return PD;
+    if(pin < 14) return PB;
+    if(pin < HAL_PIN_COUNT) return PC;
+    return NOT_A_PORT;
+}
+
+/**
+ * @brief Obtém a máscara do bit de um pino na sua porta, com o mapa de pinos do Arduino Uno
+ * 
+ * @param pin Pino digital
+ * @return uint8_t Máscara do bit
+ */
+uint8_t digitalPinToBitMask(uint8_t pin){
+    if(pin < 8) return 1 << pin;
+    if(pin < 14) return 1 << (pin - 8);
+    if(pin < HAL_PIN_COUNT) return 1 << (pin - 14);
+    return 0;
+}
+
+/**
+ * @brief Obtém o registrador de saída simulado de uma porta
+ * 
+ * @param port Identificador da porta
+ * @return volatile uint8_t* Registrador PORTx simulado
+ */
+volatile uint8_t *portOutputRegister(uint8_t port){
+    return &hal_ports[port < HAL_PORT_COUNT ? port : NOT_A_PORT];
+}
+
+/**
+ * @brief Registra o tom solicitado ao buzzer
+ * 
+ * @param pin Pino do buzzer
+ * @param frequency Frequência do tom
+ * @param duration Duração do tom em milissegundos
+ */
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration){
+    hal_tone.pin = pin;
+    hal_tone.frequency = frequency;
+    hal_tone.duration = duration;
+    hal_tone.count++;
+}
+
+/**
+ * @brief Interrompe o tom do buzzer
+ * 
+ * @param pin Pino do buzzer
+ */
+void noTone(uint8_t pin){
+    if(hal_tone.pin == pin) hal_tone.frequency = 0;
+}
+
+/**
+ * @brief Registra a rotina de uma interrupção externa
+ * 
+ * @param interruptNum Número da interrupção (0 ou 1)
+ * @param userFunc Rotina a ser chamada
+ * @param mode Borda que dispara a interrupção (ignorada na simulação)
+ */
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode){
+    (void)mode;
+    if(interruptNum >= HAL_INTERRUPT_COUNT) return;
+    hal_isrs[interruptNum] = userFunc;
+}
+
+/**
+ * @brief Remove a rotina de uma interrupção externa
+ * 
+ * @param interruptNum Número da interrupção (0 ou 1)
+ */
+void detachInterrupt(uint8_t interruptNum){
+    if(interruptNum >= HAL_INTERRUPT_COUNT) return;
+    hal_isrs[interruptNum] = NULL;
+}
+
+/**
+ * Funções matemáticas
+ */
+
+/**
+ * @brief Gera o próximo número pseudoaleatório com o algoritmo da avr-libc
+ * 
+ * @return long Número entre 0 e 0x7FFFFFFF
+ */
+long hal_do_random(){
+    int32_t hi, lo, x;
+
+    x = (int32_t)hal_random_next;
+    if(x == 0) x = 123459876L;
+    hi = x / 127773L;
+    lo = x % 127773L;
+    x = 16807L * lo - 2836L * hi;
+    if(x < 0) x += 0x7fffffffL;
+    hal_random_next = (uint32_t)x;
+    return x;
+}
+
+/**
+ * @brief Gera um número pseudoaleatório entre 0 e howbig - 1
+ * 
+ * @param howbig Limite superior (exclusivo)
+ * @return long Número gerado
+ */
+long random(long howbig){
+    if(howbig == 0) return 0;
+    return hal_do_random() % howbig;
+}
+
+/**
+ * @brief Gera um número pseudoaleatório entre howsmall e howbig - 1
+ * 
+ * @param howsmall Limite inferior (inclusivo)
+ * @param howbig Limite superior (exclusivo)
+ * @return long Número gerado
+ */
+long random(long howsmall, long howbig){
+    if(howsmall >= howbig) return howsmall;
+    return random(howbig - howsmall) + howsmall;
+}
+
+/**
+ * @brief Define a semente do gerador pseudoaleatório
+ * 
+ * @param seed Semente (0 é ignorado, como no Arduino)
+ */
+void randomSeed(unsigned long seed){
+    if(seed != 0) hal_random_next = seed;
+}
+
+/**
+ * @brief Obtém uma semente para os geradores pseudoaleatórios
+ * @note Simulada a partir do relógio virtual e da quantidade de chamadas, para que as execuções sejam reproduzíveis
+ * 
+ * @return uint32_t Semente
+ */
+uint32_t hal_entropy(){
+    uint32_t x = (uint32_t)hal_clock ^ (++hal_entropy_count * 0x9E3779B9UL);
+
+    x ^= x >> 16;
+    x *= 0x85EBCA6BUL;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35UL;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Converte um valor de uma faixa para outra, com aritmética inteira de 32 bits como no AVR
+ * 
+ * @return long Valor convertido
+ */
+long map(long x, long in_min, long in_max, long out_min, long out_max){
+    return (int32_t)((int32_t)(x - in_min) * (int32_t)(out_max - out_min) / (int32_t)(in_max - in_min) + out_min);
+}
+
+/**
+ * Serial
+ */
+
+/**
+ * @brief Constrói um novo objeto HalSerial
+ * 
+ */
+HalSerial::HalSerial(){
+    this->byteTime = 0;
+    this->txEnd = 0;
+    this->output = stdout;
+    this->rxHead = 0;
+    this->rxTail = 0;
+}
+
+/**
+ * @brief Inicializa a serial simulada
+ * 
+ * @param baud Taxa de transmissão, utilizada para calcular o tempo de cada byte (8N1)
+ */
+void HalSerial::begin(unsigned long baud){
+    this->byteTime = baud ? (10000000UL + baud - 1) / baud : 0;
+    this->txEnd = hal_clock;
+    this->rxHead = 0;
+    this->rxTail = 0;
+}
+
+/**
+ * @brief Finaliza a serial simulada
+ * 
+ */
+void HalSerial::end(){
+    flush();
+    this->byteTime = 0;
+}
+
+/**
+ * @brief Define o destino dos bytes transmitidos
+ * 
+ * @param output Arquivo de destino, ou NULL para descartar a saída
+ */
+void HalSerial::setOutput(FILE *output){
+    this->output = output;
+}
+
+/**
+ * @brief Simula a chegada de bytes pela serial. Bytes que não cabem no buffer de recepção são perdidos, como na placa
+ * @note Como a interrupção de recepção da placa, acorda hal_sleep_until()
+ * 
+ * @param data Bytes recebidos
+ * @param size Quantidade de bytes
+ * @return size_t Quantidade de bytes guardados no buffer
+ */
+size_t HalSerial::receive(const uint8_t *data, size_t size){
+    size_t n = 0;
+
+    while (n < size)
+    {
+        uint8_t next = (this->rxHead + 1) % HAL_SERIAL_RX_BUFFER;
+        if(next == this->rxTail) break;
+        this->rx[this->rxHead] = data[n++];
+        this->rxHead = next;
+    }
+    if(n) hal_wake();
+    return n;
+}
+
+/**
+ * @brief Obtém a quantidade de bytes recebidos aguardando leitura
+ * 
+ * @return int Quantidade de bytes
+ */
+int HalSerial::available(){
+    return (this->rxHead + HAL_SERIAL_RX_BUFFER - this->rxTail) % HAL_SERIAL_RX_BUFFER;
+}
+
+/**
+ * @brief Obtém o próximo byte recebido, sem retirá-lo do buffer
+ * 
+ * @return int Byte recebido, ou -1 se não houver
+ */
+int HalSerial::peek(){
+    return this->rxHead == this->rxTail ? -1 : this->rx[this->rxTail];
+}
+
+/**
+ * @brief Retira o próximo byte recebido do buffer
+ * 
+ * @return int Byte recebido, ou -1 se não houver
+ */
+int HalSerial::read(){
+    int c = peek();
+
+    if(c >= 0) this->rxTail = (this->rxTail + 1) % HAL_SERIAL_RX_BUFFER;
+    return c;
+}
+
+/**
+ * @brief Obtém o espaço livre no buffer de transmissão
+ * 
+ * @return int Quantidade de bytes que podem ser escritos sem bloquear
+ */
+int HalSerial::availableForWrite(){
+    if(this->byteTime == 0 || this->txEnd <= hal_clock) return HAL_SERIAL_TX_BUFFER - 1;
+    uint32_t pending = (uint32_t)((this->txEnd - hal_clock + this->byteTime - 1) / this->byteTime);
+    return pending >= HAL_SERIAL_TX_BUFFER - 1 ? 0 : HAL_SERIAL_TX_BUFFER - 1 - pending;
+}
+
+/**
+ * @brief Aguarda a transmissão de todos os bytes do buffer
+ * 
+ */
+void HalSerial::flush(){
+    if(this->txEnd > hal_clock) hal_clock_advance((uint32_t)(this->txEnd - hal_clock));
+    if(this->output) fflush(this->output);
+}
+
+/**
+ * @brief Transmite um byte, bloqueando enquanto o buffer estiver cheio
+ * 
+ * @param c Byte a ser transmitido
+ * @return size_t Quantidade de bytes escritos
+ */
+size_t HalSerial::write(uint8_t c){
+    if(this->byteTime){
+        if(availableForWrite() == 0){
+            uint64_t freeAt = this->txEnd - (uint64_t)(HAL_SERIAL_TX_BUFFER - 2) * this->byteTime;
+            hal_clock_advance((uint32_t)(freeAt - hal_clock));
+        }
+        if(this->txEnd < hal_clock) this->txEnd = hal_clock;
+        this->txEnd += this->byteTime;
+    }
+    if(this->output) fputc(c, this->output);
+    return 1;
+}
+
+/**
+ * @brief Transmite um bloco de bytes
+ * 
+ * @param buffer Bytes a serem transmitidos
+ * @param size Quantidade de bytes
+ * @return size_t Quantidade de bytes escritos
+ */
+size_t HalSerial::write(const uint8_t *buffer, size_t size){
+    for (size_t i = 0; i < size; i++)
+    {
+        write(buffer[i]);
+    }
+    return size;
+}
+
+size_t HalSerial::printNumber(unsigned long n, uint8_t base){
+    char buf[8 * sizeof(long) + 1];
+    char *str = &buf[sizeof(buf) - 1];
+
+    *str = '\0';
+    if(base < 2) base = 10;
+    do
+    {
+        char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while (n);
+
+    return print(str);
+}
+
+size_t HalSerial::print(const char *str){
+    size_t n = 0;
+    while (str[n])
+    {
+        write((uint8_t)str[n]);
+        n++;
+    }
+    return n;
+}
+
+size_t HalSerial::print(char c){
+    return write((uint8_t)c);
+}
+
+size_t HalSerial::print(int n, int base){
+    return print((long)n, base);
+}
+
+size_t HalSerial::print(unsigned int n, int base){
+    return print((unsigned long)n, base);
+}
+
+size_t HalSerial::print(long n, int base){
+    if(base == 10 && n < 0){
+        return print('-') + printNumber((unsigned long)-n, 10);
+    }
+    return printNumber((unsigned long)n, base);
+}
+
+size_t HalSerial::print(unsigned long n, int base){
+    return printNumber(n, base);
+}
+
+size_t HalSerial::println(){
+    return print("\r\n");
+}
+
+size_t HalSerial::println(const char *str){
+    return print(str) + println();
+}
+
+size_t HalSerial::println(char c){
+    return print(c) + println();
+}
+
+size_t HalSerial::println(int n, int base){
+    return print(n, base) + println();
+}
+
+size_t HalSerial::println(unsigned int n, int base){
+    return print(n, base) + println();
+}
+
+size_t HalSerial::println(long n, int base){
+    return print(n, base) + println();
+}
+
+size_t HalSerial::println(unsigned long n, int base){
+    return print(n, base) + println();
+}
+
+/**
+ * SPI
+ */
+
+/**
+ * @brief Constrói um novo objeto SPISettings
+ * 
+ * @param clock Frequência do clock
+ * @param bitOrder MSBFIRST ou LSBFIRST
+ * @param dataMode Modo SPI
+ */
+SPISettings::SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode){
+    this->clock = clock;
+    this->bitOrder = bitOrder;
+    this->dataMode = dataMode;
+}
+
+void HalSPI::begin(){
+}
+
+void HalSPI::end(){
+}
+
+void HalSPI::beginTransaction(SPISettings settings){
+    (void)settings;
+}
+
+void HalSPI::endTransaction(){
+}
+
+/**
+ * @brief Transfere um byte, deslocando a cascata de registradores simulados
+ * 
+ * @param data Byte transmitido
+ * @return uint8_t Byte que sai do último registrador da cascata
+ */
+uint8_t HalSPI::transfer(uint8_t data){
+    uint8_t out = hal_spi_chain[HAL_SPI_CHAIN - 1];
+
+    for (size_t i = HAL_SPI_CHAIN - 1; i > 0; i--)
+    {
+        hal_spi_chain[i] = hal_spi_chain[i - 1];
+    }
+    hal_spi_chain[0] = data;
+    hal_spi_count++;
+    return out;
+}
+
+/**
+ * EEPROM simulada
+ */
+
+/**
+ * @brief Constrói a EEPROM simulada, apagada
+ * 
+ */
+HalEeprom::HalEeprom(){
+    for (size_t i = 0; i < HAL_EEPROM_SIZE; i++)
+    {
+        this->data[i] = 0xFF;
+    }
+    this->writes = 0;
+}
+
+/**
+ * @brief Lê uma célula da EEPROM
+ * 
+ * @param idx Endereço
+ * @return uint8_t Conteúdo da célula (0xFF fora da memória)
+ */
+uint8_t HalEeprom::read(int idx){
+    if(idx < 0 || idx >= HAL_EEPROM_SIZE) return 0xFF;
+    return this->data[idx];
+}
+
+/**
+ * @brief Grava uma célula da EEPROM
+ * 
+ * @param idx Endereço
+ * @param value Novo conteúdo
+ */
+void HalEeprom::write(int idx, uint8_t value){
+    if(idx < 0 || idx >= HAL_EEPROM_SIZE) return;
+    this->data[idx] = value;
+    this->writes++;
+}
+
+/**
+ * @brief Grava uma célula da EEPROM somente se o conteúdo mudar, poupando o desgaste
+ * 
+ * @param idx Endereço
+ * @param value Novo conteúdo
+ */
+void HalEeprom::update(int idx, uint8_t value){
+    if(read(idx) != value) write(idx, value);
+}
+
+/**
+ * @brief Obtém o tamanho da EEPROM
+ * 
+ * @return uint16_t Tamanho em bytes
+ */
+uint16_t HalEeprom::length(){
+    return HAL_EEPROM_SIZE;
+}
+
+/**
+ * @brief Obtém a quantidade de gravações efetivas, para conferir o desgaste
+ * 
+ * @return uint32_t Quantidade de células gravadas desde o início do programa
+ */
+uint32_t HalEeprom::writeCount(){
+    return this->writes;
+}
+
+/**
+ * Controle do ambiente simulado
+ */
+
+/**
+ * @brief Reinicia o relógio virtual, os pinos, as interrupções e o gerador pseudoaleatório
+ * 
+ */
+void hal_reset(){
+    hal_clock = 0;
+    for (size_t i = 0; i < HAL_PIN_COUNT; i++)
+    {
+        hal_pins_mode[i] = INPUT;
+    }
+    for (size_t i = 0; i < HAL_PORT_COUNT; i++)
+    {
+        hal_ports[i] = 0;
+    }
+    for (size_t i = 0; i < HAL_INTERRUPT_COUNT; i++)
+    {
+        hal_isrs[i] = NULL;
+    }
+    hal_tone.pin = 0;
+    hal_tone.frequency = 0;
+    hal_tone.duration = 0;
+    hal_tone.count = 0;
+    hal_random_next = 1;
+    hal_entropy_count = 0;
+    for (size_t i = 0; i < HAL_EVENT_COUNT; i++)
+    {
+        hal_events[i].pending = false;
+    }
+    hal_wake_pending = false;
+    hal_slept = 0;
+    hal_timer_isr = NULL;
+    for (size_t i = 0; i < HAL_SPI_CHAIN; i++)
+    {
+        hal_spi_chain[i] = 0;
+    }
+    hal_spi_count = 0;
+    Serial.begin(0);
+}
+
+/**
+ * @brief Obtém o valor completo do relógio virtual
+ * 
+ * @return uint64_t Tempo em microssegundos
+ */
+uint64_t hal_clock_us(){
+    return hal_clock;
+}
+
+/**
+ * @brief Obtém a próxima interrupção agendada até o instante informado
+ * 
+ * @param until Limite da busca, em microssegundos
+ * @return hal_event_t* Evento mais próximo, ou NULL se não houver
+ */
+hal_event_t *hal_next_event(uint64_t until){
+    hal_event_t *next = NULL;
+
+    for (size_t i = 0; i < HAL_EVENT_COUNT; i++)
+    {
+        hal_event_t *event = &hal_events[i];
+        if(event->pending && event->at <= until && (next == NULL || event->at < next->at)) next = event;
+    }
+    return next;
+}
+
+/**
+ * @brief Avança o relógio até o instante informado, disparando as interrupções agendadas no caminho
+ * 
+ * @param until Instante final, em microssegundos
+ * @param stopOnWake Interrompe o avanço quando uma interrupção chama hal_wake()
+ */
+void hal_run_until(uint64_t until, bool stopOnWake){
+    while (1)
+    {
+        hal_event_t *event = hal_next_event(until);
+
+        if(hal_timer_isr && hal_timer_at <= until && (event == NULL || hal_timer_at <= event->at)){
+            if(hal_timer_at > hal_clock) hal_clock = hal_timer_at;
+            hal_timer_at += hal_timer_period;
+            hal_timer_isr();
+            continue;
+        }
+        if(event == NULL) break;
+
+        if(event->at > hal_clock) hal_clock = event->at;
+        event->pending = false;
+        hal_trigger_interrupt(event->interruptNum);
+        if(stopOnWake && hal_wake_pending) return;
+    }
+    if(until > hal_clock) hal_clock = until;
+}
+
+/**
+ * @brief Avança o relógio virtual, disparando as interrupções agendadas no caminho
+ * 
+ * @param us Tempo em microssegundos
+ */
+void hal_clock_advance(uint32_t us){
+    hal_run_until(hal_clock + us, false);
+}
+
+/**
+ * @brief Obtém o modo configurado de um pino
+ * 
+ * @param pin Pino consultado
+ * @return uint8_t INPUT, OUTPUT ou INPUT_PULLUP
+ */
+uint8_t hal_pin_mode(uint8_t pin){
+    return pin < HAL_PIN_COUNT ? hal_pins_mode[pin] : INPUT;
+}
+
+/**
+ * @brief Obtém o estado de saída de um pino
+ * 
+ * @param pin Pino consultado
+ * @return uint8_t HIGH ou LOW
+ */
+uint8_t hal_pin_state(uint8_t pin){
+    if(pin >= HAL_PIN_COUNT) return LOW;
+    return (*portOutputRegister(digitalPinToPort(pin)) & digitalPinToBitMask(pin)) ? HIGH : LOW;
+}
+
+/**
+ * @brief Copia os registradores de porta simulados
+ * 
+ * @param ports Destino da cópia
+ */
+void hal_ports_save(uint8_t ports[HAL_PORT_COUNT]){
+    for (size_t i = 0; i < HAL_PORT_COUNT; i++)
+    {
+        ports[i] = hal_ports[i];
+    }
+}
+
+/**
+ * @brief Compara os registradores de porta simulados com uma cópia anterior
+ * 
+ * @param ports Cópia salva com hal_ports_save()
+ * @return true Se todos os registradores são iguais à cópia
+ */
+bool hal_ports_equal(const uint8_t ports[HAL_PORT_COUNT]){
+    for (size_t i = 0; i < HAL_PORT_COUNT; i++)
+    {
+        if(ports[i] != hal_ports[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Obtém o último tom solicitado ao buzzer
+ * 
+ * @return const hal_tone_t* Dados do último tom
+ */
+const hal_tone_t *hal_last_tone(){
+    return &hal_tone;
+}
+
+/**
+ * @brief Simula o disparo de uma interrupção externa (ex.: botão pressionado)
+ * 
+ * @param interruptNum Número da interrupção (0 ou 1)
+ */
+void hal_trigger_interrupt(uint8_t interruptNum){
+    if(interruptNum >= HAL_INTERRUPT_COUNT) return;
+    if(hal_isrs[interruptNum]) hal_isrs[interruptNum]();
+}
+
+/**
+ * @brief Agenda o disparo de uma interrupção externa no relógio virtual
+ * 
+ * @param interruptNum Número da interrupção (0 ou 1)
+ * @param at Instante do disparo (millis)
+ * @return true Se o evento foi agendado
+ * @return false Se não há espaço para mais eventos
+ */
+bool hal_schedule_interrupt(uint8_t interruptNum, uint32_t at){
+    for (size_t i = 0; i < HAL_EVENT_COUNT; i++)
+    {
+        hal_event_t *event = &hal_events[i];
+        if(event->pending) continue;
+        event->at = (uint64_t)at * 1000;
+        event->interruptNum = interruptNum;
+        event->pending = true;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Funções comuns a todos os ambientes
+ */
+
+/**
+ * @brief Encerra o sono atual. Deve ser chamada pelas rotinas de interrupção que mudam o estado da aplicação
+ * 
+ */
+void hal_wake(){
+    hal_wake_pending = true;
+}
+
+/**
+ * @brief Inicia o temporizador periódico. No relógio virtual a rotina é chamada exatamente a cada período
+ * 
+ * @param periodUs Período em microssegundos
+ * @param isr Rotina chamada a cada período
+ * @return true Sempre, no ambiente native
+ */
+bool hal_timer_start(uint32_t periodUs, void (*isr)(void)){
+    if(periodUs == 0 || isr == NULL) return false;
+
+    hal_timer_period = periodUs;
+    hal_timer_at = hal_clock + periodUs;
+    hal_timer_isr = isr;
+    return true;
+}
+
+/**
+ * @brief Para o temporizador periódico
+ * 
+ */
+void hal_timer_stop(){
+    hal_timer_isr = NULL;
+}
+
+/**
+ * @brief Obtém os ciclos da CPU desde o início do período atual do temporizador
+ * @note O relógio virtual chama a rotina exatamente no início do período e não avança durante ela, então o valor é sempre 0.
+ * O atraso real da interrupção só é medido no AVR
+ * 
+ * @return uint32_t Sempre 0, no ambiente native
+ */
+uint32_t hal_timer_cycles(){
+    return 0;
+}
+
+/**
+ * @brief Avança o relógio até o prazo informado, ou até uma interrupção agendada chamar hal_wake() ou chegarem bytes pela serial
+ * 
+ * @param deadline Instante (millis) em que a aplicação precisa ser atualizada
+ */
+void hal_sleep_until(uint32_t deadline){
+    int32_t remaining = (int32_t)(deadline - millis());
+    uint64_t start = hal_clock;
+
+    if(remaining > 0 && !hal_wake_pending && !Serial.available()){
+        hal_run_until((hal_clock / 1000 + remaining) * 1000, true);
+    }
+    hal_wake_pending = false;
+    hal_slept += hal_clock - start;
+}
+
+/**
+ * @brief Obtém o tempo total dormindo em hal_sleep_until()
+ * 
+ * @return uint64_t Tempo em microssegundos
+ */
+uint64_t hal_sleep_us(){
+    return hal_slept;
+}
+
+
+/**
+ * @brief Obtém o conteúdo de um registrador de deslocamento simulado no SPI
+ * 
+ * @param index Posição na cascata (0 = ligado ao MOSI)
+ * @return uint8_t Conteúdo do registrador
+ */
+uint8_t hal_spi_register(uint8_t index){
+    return index < HAL_SPI_CHAIN ? hal_spi_chain[index] : 0;
+}
+
+/**
+ * @brief Obtém a quantidade de bytes transferidos pelo SPI desde o reset
+ * 
+ * @return uint32_t Quantidade de bytes
+ */
+uint32_t hal_spi_transfers(){
+    return hal_spi_count;
+}
+
+#endif  //!ARDUINO
@@ -0,0 +1,251 @@
+/**
+ * @file hal_native.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Shim da API do Arduino para execução no computador (env:native)
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Todas as funções de tempo trabalham sobre um relógio virtual em
+ * microssegundos. O relógio só avança quando o código chama delay(),
+ * delayMicroseconds(), quando a serial precisa esperar a transmissão ou
+ * através de hal_clock_advance(). Assim a lógica da roleta pode rodar
+ * milhares de vezes mais rápido que o tempo real.
+ * 
+ */
+
+#ifndef __HAL_NATIVE__H__
+#define __HAL_NATIVE__H__
+
+#ifndef ARDUINO
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#define HAL_NATIVE 1                    //!< Indica que o shim do computador está em uso
+
+#ifdef HAL_THREADS
+#define HAL_THREAD_LOCAL thread_local   //!< Cada thread simula a sua própria placa (ferramentas paralelas, ex.: tools/fairness)
+#else
+#define HAL_THREAD_LOCAL                //!< Estado global único do shim
+#endif
+
+#define HAL_PIN_COUNT 20                //!< Quantidade de pinos digitais simulados (Arduino Uno)
+#define HAL_INTERRUPT_COUNT 2           //!< Quantidade de interrupções externas simuladas (INT0 e INT1)
+#define HAL_SERIAL_TX_BUFFER 64         //!< Tamanho do buffer de transmissão da serial simulada
+#define HAL_SERIAL_RX_BUFFER 64         //!< Tamanho do buffer de recepção da serial simulada
+#define HAL_EVENT_COUNT 8               //!< Quantidade máxima de interrupções agendadas no relógio virtual
+#define HAL_PORT_COUNT 5                //!< Quantidade de identificadores de porta (NOT_A_PORT, -, PB, PC, PD)
+#define HAL_SPI_CHAIN 8                 //!< Quantidade de registradores de deslocamento simulados no SPI
+#define HAL_EEPROM_SIZE 1024            //!< Tamanho da EEPROM simulada (Arduino Uno)
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+#define SPI_MODE0 0x00
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define digitalPinToInterrupt(p) ((p) == 2 ? 0 : ((p) == 3 ? 1 : -1))
+
+#define NOT_A_PIN 0
+#define NOT_A_PORT 0
+#define PB 2
+#define PC 3
+#define PD 4
+
+#define interrupts()
+#define noInterrupts()
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(const void *const *)(addr))
+#define PSTR(s) (s)
+#define strcmp_P(a, b) strcmp((a), (b))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+/**
+ * API do Arduino
+ */
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+volatile uint8_t *portOutputRegister(uint8_t port);
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+/**
+ * @brief Porta serial simulada
+ * 
+ * A transmissão respeita a taxa configurada em begin(): quando o buffer de
+ * transmissão enche, a escrita bloqueia e o relógio virtual avança o tempo
+ * que a UART levaria para liberar espaço, como acontece na placa. Os bytes
+ * recebidos são injetados com receive(), que acorda hal_sleep_until(), e lidos
+ * com available()/read().
+ */
+class HalSerial
+{
+private:
+    uint32_t byteTime;              //!< Tempo de transmissão de um byte em microssegundos (0 = instantâneo)
+    uint64_t txEnd;                 //!< Instante em que o último byte do buffer termina de ser transmitido
+    FILE *output;                   //!< Destino dos bytes transmitidos (NULL descarta)
+    uint8_t rx[HAL_SERIAL_RX_BUFFER];   //!< Buffer de recepção
+    uint8_t rxHead;                 //!< Próxima posição a ser escrita no buffer de recepção
+    uint8_t rxTail;                 //!< Próxima posição a ser lida do buffer de recepção
+    size_t printNumber(unsigned long n, uint8_t base);
+public:
+    HalSerial();
+    void begin(unsigned long baud);
+    void end();
+    void setOutput(FILE *output);
+    size_t receive(const uint8_t *data, size_t size);
+    int available();
+    int peek();
+    int read();
+    int availableForWrite();
+    void flush();
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buffer, size_t size);
+    size_t print(const char *str);
+    size_t print(char c);
+    size_t print(int n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t println();
+    size_t println(const char *str);
+    size_t println(char c);
+    size_t println(int n, int base = DEC);
+    size_t println(unsigned int n, int base = DEC);
+    size_t println(long n, int base = DEC);
+    size_t println(unsigned long n, int base = DEC);
+};
+
+extern HAL_THREAD_LOCAL HalSerial Serial;
+
+/**
+ * @brief Configuração de uma transação SPI
+ */
+class SPISettings
+{
+public:
+    uint32_t clock;                 //!< Frequência do clock
+    uint8_t bitOrder;               //!< MSBFIRST ou LSBFIRST
+    uint8_t dataMode;               //!< Modo SPI
+    SPISettings(uint32_t clock = 4000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0);
+};
+
+/**
+ * @brief SPI simulado. Os bytes transferidos são deslocados por uma cascata de registradores simulados
+ */
+class HalSPI
+{
+public:
+    void begin();
+    void end();
+    void beginTransaction(SPISettings settings);
+    void endTransaction();
+    uint8_t transfer(uint8_t data);
+};
+
+extern HAL_THREAD_LOCAL HalSPI SPI;
+
+/**
+ * @brief EEPROM simulada, com a mesma API da biblioteca EEPROM do Arduino
+ * @note Começa apagada (0xFF) e, como na placa, não é alterada por hal_reset()
+ */
+class HalEeprom
+{
+private:
+    uint8_t data[HAL_EEPROM_SIZE];  //!< Conteúdo da memória
+    uint32_t writes;                //!< Quantidade de células efetivamente gravadas
+public:
+    HalEeprom();
+    uint8_t read(int idx);
+    void write(int idx, uint8_t value);
+    void update(int idx, uint8_t value);
+    uint16_t length();
+    uint32_t writeCount();
+};
+
+extern HAL_THREAD_LOCAL HalEeprom EEPROM;
+
+/**
+ * Controle do ambiente simulado
+ */
+
+/**
+ * @brief Último tom solicitado ao buzzer
+ */
+typedef struct
+{
+    uint8_t pin;                    //!< Pino do buzzer
+    unsigned int frequency;         //!< Frequência do tom
+    unsigned long duration;         //!< Duração do tom em milissegundos
+    uint32_t count;                 //!< Quantidade de chamadas de tone() desde o reset
+}hal_tone_t;
+
+void hal_reset();
+uint64_t hal_clock_us();
+void hal_clock_advance(uint32_t us);
+uint8_t hal_pin_mode(uint8_t pin);
+uint8_t hal_pin_state(uint8_t pin);
+void hal_ports_save(uint8_t ports[HAL_PORT_COUNT]);
+bool hal_ports_equal(const uint8_t ports[HAL_PORT_COUNT]);
+uint8_t hal_spi_register(uint8_t index);
+uint32_t hal_spi_transfers();
+const hal_tone_t *hal_last_tone();
+void hal_trigger_interrupt(uint8_t interruptNum);
+bool hal_schedule_interrupt(uint8_t interruptNum, uint32_t at);
+
+#endif  //!ARDUINO
+
+#endif  //!__HAL_NATIVE__H__
@@ -0,0 +1,72 @@
+/**
+ * @file soft_timer.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Temporizadores por software baseados em prazo (deadline), sem bloqueio
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "soft_timer.h"
+
+/**
+ * @brief Inicia o temporizador a partir do instante atual
+ * 
+ * @param timer Temporizador
+ * @param ms Tempo até o prazo, em milissegundos
+ */
+void soft_timer_start(soft_timer_t *timer, uint32_t ms){
+    timer->deadline = millis() + ms;
+    timer->armed = true;
+}
+
+/**
+ * @brief Agenda o próximo prazo a partir do prazo anterior, evitando acumular atrasos do loop
+ * @note Se o temporizador estiver parado, ou atrasado mais que um período, o prazo é contado a partir do instante atual
+ * 
+ * @param timer Temporizador
+ * @param ms Tempo até o próximo prazo, em milissegundos
+ */
+void soft_timer_next(soft_timer_t *timer, uint32_t ms){
+    uint32_t now = millis();
+
+    if(!timer->armed || (int32_t)(now - timer->deadline) >= (int32_t)ms){
+        timer->deadline = now + ms;
+    }else{
+        timer->deadline += ms;
+    }
+    timer->armed = true;
+}
+
+/**
+ * @brief Para o temporizador. Um temporizador parado é considerado expirado
+ * 
+ * @param timer Temporizador
+ */
+void soft_timer_stop(soft_timer_t *timer){
+    timer->armed = false;
+}
+
+/**
+ * @brief Verifica se o prazo do temporizador já passou
+ * 
+ * @param timer Temporizador
+ * @return true Se o prazo passou, ou se o temporizador está parado
+ * @return false Enquanto o prazo não for atingido
+ */
+bool soft_timer_expired(const soft_timer_t *timer){
+    return !timer->armed || (int32_t)(millis() - timer->deadline) >= 0;
+}
+
+
+/**
+ * @brief Obtém o prazo do temporizador
+ * 
+ * @param timer Temporizador
+ * @return uint32_t Instante (millis) do prazo. Se o temporizador estiver parado, o instante atual
+ */
+uint32_t soft_timer_deadline(const soft_timer_t *timer){
+    return timer->armed ? timer->deadline : millis();
+}
\ No newline at end of file
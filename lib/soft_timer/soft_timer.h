@@ -0,0 +1,33 @@
+/**
+ * @file soft_timer.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Temporizadores por software baseados em prazo (deadline), sem bloqueio
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __SOFTTIMER__H__
+#define __SOFTTIMER__H__
+
+#include "hal.h"
+
+/**
+ * @brief Estrutura de dados de um temporizador
+ * 
+ */
+typedef struct
+{
+    uint32_t deadline;              //!< Instante (millis) em que o temporizador expira
+    bool armed;                     //!< Temporizador em contagem
+}soft_timer_t;
+
+void soft_timer_start(soft_timer_t *timer, uint32_t ms);
+void soft_timer_next(soft_timer_t *timer, uint32_t ms);
+void soft_timer_stop(soft_timer_t *timer);
+bool soft_timer_expired(const soft_timer_t *timer);
+uint32_t soft_timer_deadline(const soft_timer_t *timer);
+
+#endif  //!__SOFTTIMER__H__
@@ -0,0 +1,388 @@
+/**
+ * @file spin_batch.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Simulação em lote, no computador, dos sorteios de milhares de roletas com a mesma configuração
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "spin_batch.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#define SPIN_BATCH_STOPPED 0x10000      //!< Distância do prazo até o primeiro passo de cada giro: maior que qualquer passo, como um temporizador parado
+
+/**
+ * Protótipos das funções privadas
+ */
+static bool spin_batch_build_tables(spin_batch_t *batch);
+static void spin_batch_plan(spin_batch_t *batch, uint32_t wheel);
+#ifdef __AVX2__
+static void spin_batch_run_avx2(spin_batch_t *batch, uint32_t first, uint32_t until);
+#else
+static void spin_batch_run_scalar(spin_batch_t *batch, uint32_t wheel, uint32_t until);
+#endif
+
+/**
+ * Funções Públicas
+ */
+
+/**
+ * @brief Aloca o lote e calcula as tabelas dos giros
+ * @note Todas as roletas começam no instante 0, com o led 0 selecionado e a lista zerada (ver spin_batch_begin)
+ *
+ * @param batch Lote a ser inicializado
+ * @param count Quantidade de roletas
+ * @param config Configuração comum a todas as roletas
+ * @return true Se o lote foi alocado
+ * @return false Se a configuração tem um giro que nunca termina (ex.: desaceleração 0), pausa 0, ou falta memória
+ */
+bool spin_batch_init(spin_batch_t *batch, uint32_t count, const spin_batch_config_t *config){
+    int32_t **fields[] = {&batch->selectedLed, &batch->step, &batch->stopStep, &batch->row, &batch->listIdx,
+        &batch->due, &batch->deadline, &batch->start, &batch->draws, &batch->result, &batch->lastStop,
+        &batch->spinning, &batch->steps};
+    size_t fieldCount = sizeof(fields) / sizeof(fields[0]);
+
+    memset(batch, 0, sizeof(spin_batch_t));
+    if(count == 0 || config->ledsCount == 0 || config->pause == 0) return false;
+
+    batch->count = count;
+    batch->stride = (count + SPIN_BATCH_LANES - 1) / SPIN_BATCH_LANES * SPIN_BATCH_LANES;
+    batch->config = *config;
+
+    if(!spin_batch_build_tables(batch)){
+        spin_batch_free(batch);
+        return false;
+    }
+
+    for (size_t f = 0; f < fieldCount; f++)
+    {
+        *fields[f] = (int32_t *)calloc(batch->stride, sizeof(int32_t));
+        if(*fields[f] == NULL){
+            spin_batch_free(batch);
+            return false;
+        }
+    }
+    batch->numbers = (int32_t *)calloc((size_t)batch->stride * SPIN_BATCH_LIST_SIZE, sizeof(int32_t));
+    if(batch->numbers == NULL){
+        spin_batch_free(batch);
+        return false;
+    }
+
+    for (uint32_t wheel = 0; wheel < batch->stride; wheel++)
+    {
+        spin_batch_begin(batch, wheel, 0);
+    }
+    return true;
+}
+
+/**
+ * @brief Libera a memória do lote
+ *
+ * @param batch Lote
+ */
+void spin_batch_free(spin_batch_t *batch){
+    int32_t *fields[] = {batch->selectedLed, batch->step, batch->stopStep, batch->row, batch->listIdx,
+        batch->due, batch->deadline, batch->start, batch->draws, batch->result, batch->lastStop,
+        batch->spinning, batch->steps, batch->numbers, batch->times, batch->plans, batch->rows};
+
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++)
+    {
+        free(fields[f]);
+    }
+    memset(batch, 0, sizeof(spin_batch_t));
+}
+
+/**
+ * @brief Define a lista de números de uma roleta, repetida a cada SPIN_BATCH_LIST_SIZE sorteios
+ * @note Vale a partir do próximo spin_batch_begin()
+ *
+ * @param batch Lote
+ * @param wheel Índice da roleta
+ * @param numbers Números de 1 a ledsCount, como em ElectronicRoulette::setNumbersList()
+ */
+void spin_batch_set_numbers(spin_batch_t *batch, uint32_t wheel, const uint8_t numbers[SPIN_BATCH_LIST_SIZE]){
+    for (uint32_t k = 0; k < SPIN_BATCH_LIST_SIZE; k++)
+    {
+        uint8_t led = numbers[k] - 1;
+        batch->numbers[k * batch->stride + wheel] = led < batch->config.ledsCount ? led : 0;
+    }
+}
+
+/**
+ * @brief Reinicia uma roleta, com o primeiro giro no instante indicado
+ * @note Equivale a uma ElectronicRoulette recém-criada que recebe o botão de iniciar em time
+ *
+ * @param batch Lote
+ * @param wheel Índice da roleta
+ * @param time Instante (millis) do primeiro passo
+ */
+void spin_batch_begin(spin_batch_t *batch, uint32_t wheel, uint32_t time){
+    batch->selectedLed[wheel] = 0;
+    batch->listIdx[wheel] = 0;
+    batch->due[wheel] = time;
+    batch->deadline[wheel] = time - SPIN_BATCH_STOPPED;
+    batch->start[wheel] = time;
+    batch->draws[wheel] = 0;
+    batch->result[wheel] = 0;
+    batch->lastStop[wheel] = time;
+    batch->spinning[wheel] = 0;
+    batch->steps[wheel] = 0;
+    spin_batch_plan(batch, wheel);
+}
+
+/**
+ * @brief Avança todas as roletas, executando os passos com instante até until
+ *
+ * @param batch Lote
+ * @param until Instante (millis) final
+ */
+void spin_batch_run(spin_batch_t *batch, uint32_t until){
+#ifdef __AVX2__
+    for (uint32_t first = 0; first < batch->stride; first += SPIN_BATCH_LANES)
+    {
+        spin_batch_run_avx2(batch, first, until);
+    }
+#else
+    for (uint32_t wheel = 0; wheel < batch->stride; wheel++)
+    {
+        spin_batch_run_scalar(batch, wheel, until);
+    }
+#endif
+}
+
+/**
+ * @brief Informa se spin_batch_run() foi compilado com AVX2
+ *
+ * @return true Se as roletas são avançadas 8 por vez
+ */
+bool spin_batch_has_avx2(){
+#ifdef __AVX2__
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Funções Privadas
+ */
+
+/**
+ * @brief Calcula o passo de parada de cada par (led inicial, led sorteado) e a duração dos passos de cada giro
+ *
+ * Cada par é planejado sobre uma cópia do perfil, como em
+ * ElectronicRoulette::planSpin(). Como o perfil planejado só depende do
+ * último passo, há uma tabela de passos por passo de parada.
+ *
+ * @param batch Lote, com config preenchida
+ * @return true Se todos os giros terminam
+ */
+static bool spin_batch_build_tables(spin_batch_t *batch){
+    const spin_batch_config_t *config = &batch->config;
+    uint32_t pairs = (uint32_t)config->ledsCount * config->ledsCount;
+    spin_profile_t base;
+    spin_profile_t plan;
+    int32_t maxStop = 0;
+
+    spin_profile_build(&base, config->time, config->deceleration, config->stopDeceleration, config->ledsCount, config->easing);
+
+    batch->plans = (int32_t *)malloc(pairs * sizeof(int32_t));
+    batch->rows = (int32_t *)malloc(pairs * sizeof(int32_t));
+    if(batch->plans == NULL || batch->rows == NULL) return false;
+
+    batch->minStop = SPIN_PROFILE_ENDLESS;
+    for (uint32_t pair = 0; pair < pairs; pair++)
+    {
+        uint8_t startLed = pair / config->ledsCount;
+        uint8_t target = pair % config->ledsCount;
+        uint16_t stop;
+
+        plan = base;
+        stop = config->stopPlanner ? spin_profile_plan(&plan, config->spinTime, startLed, target) : spin_profile_stop_step(&plan, startLed, target);
+        if(stop == SPIN_PROFILE_ENDLESS) return false;
+
+        batch->plans[pair] = stop;
+        if(stop < batch->minStop) batch->minStop = stop;
+        if(stop > maxStop) maxStop = stop;
+    }
+
+    if(maxStop < batch->minStop) return false;
+
+    batch->rowSize = maxStop + 1;
+    batch->times = (int32_t *)calloc((size_t)(maxStop - batch->minStop + 1) * batch->rowSize, sizeof(int32_t));
+    if(batch->times == NULL) return false;
+
+    for (uint32_t pair = 0; pair < pairs; pair++)
+    {
+        int32_t stop = batch->plans[pair];
+        int32_t *row = batch->times + (size_t)(stop - batch->minStop) * batch->rowSize;
+
+        batch->rows[pair] = row - batch->times;
+        plan = base;
+        if(config->stopPlanner) spin_profile_plan(&plan, config->spinTime, pair / config->ledsCount, pair % config->ledsCount);
+        for (int32_t step = 0; step <= stop; step++)
+        {
+            row[step] = spin_profile_step_time(&plan, step);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Planeja o giro de uma roleta a partir do led selecionado e do número atual da lista
+ *
+ * @param batch Lote
+ * @param wheel Índice da roleta
+ */
+static void spin_batch_plan(spin_batch_t *batch, uint32_t wheel){
+    int32_t target = batch->numbers[batch->listIdx[wheel] * batch->stride + wheel];
+    int32_t pair = batch->selectedLed[wheel] * batch->config.ledsCount + target;
+
+    batch->step[wheel] = 0;
+    batch->stopStep[wheel] = batch->plans[pair];
+    batch->row[wheel] = batch->rows[pair];
+}
+
+#ifndef __AVX2__
+/**
+ * @brief Avança uma roleta, executando os passos com instante até until
+ * @note spin_batch_run_avx2() faz as mesmas operações em 8 roletas
+ *
+ * @param batch Lote
+ * @param wheel Índice da roleta
+ * @param until Instante (millis) final
+ */
+static void spin_batch_run_scalar(spin_batch_t *batch, uint32_t wheel, uint32_t until){
+    while ((int32_t)(batch->due[wheel] - until) <= 0)
+    {
+        uint32_t due = batch->due[wheel];
+        int32_t time = batch->times[batch->row[wheel] + batch->step[wheel]];
+
+        // soft_timer_next(), com millis() igual ao instante do passo
+        if((int32_t)(due - batch->deadline[wheel]) >= time){
+            batch->deadline[wheel] = due + time;
+        }else{
+            batch->deadline[wheel] += time;
+        }
+        batch->steps[wheel]++;
+
+        if(batch->step[wheel] == batch->stopStep[wheel]){
+            batch->result[wheel] = batch->selectedLed[wheel];
+            batch->lastStop[wheel] = due;
+            batch->draws[wheel]++;
+            batch->spinning[wheel] += (int32_t)(due - batch->start[wheel]);
+            batch->listIdx[wheel] = batch->listIdx[wheel] + 1 < SPIN_BATCH_LIST_SIZE ? batch->listIdx[wheel] + 1 : 0;
+            batch->start[wheel] = due + batch->config.pause;
+            batch->due[wheel] = batch->start[wheel];
+            batch->deadline[wheel] = batch->start[wheel] - SPIN_BATCH_STOPPED;
+            spin_batch_plan(batch, wheel);
+            continue;
+        }
+
+        batch->selectedLed[wheel] = batch->selectedLed[wheel] + 1 < batch->config.ledsCount ? batch->selectedLed[wheel] + 1 : 0;
+        batch->step[wheel]++;
+        batch->due[wheel] = batch->deadline[wheel];
+    }
+}
+#else
+/**
+ * @brief Avança 8 roletas consecutivas, executando os passos com instante até until
+ * @note Cada iteração executa um passo das roletas em que ele já venceu; as demais ficam mascaradas
+ *
+ * @param batch Lote
+ * @param first Índice da primeira roleta (múltiplo de SPIN_BATCH_LANES)
+ * @param until Instante (millis) final
+ */
+static void spin_batch_run_avx2(spin_batch_t *batch, uint32_t first, uint32_t until){
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i ones = _mm256_set1_epi32(-1);
+    const __m256i leds = _mm256_set1_epi32(batch->config.ledsCount);
+    const __m256i listSize = _mm256_set1_epi32(SPIN_BATCH_LIST_SIZE);
+    const __m256i pause = _mm256_set1_epi32(batch->config.pause);
+    const __m256i stopped = _mm256_set1_epi32(SPIN_BATCH_STOPPED);
+    const __m256i stride = _mm256_set1_epi32(batch->stride);
+    const __m256i limit = _mm256_set1_epi32(until);
+    const __m256i lane = _mm256_add_epi32(_mm256_set1_epi32(first), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+    __m256i selectedLed = _mm256_loadu_si256((const __m256i *)(batch->selectedLed + first));
+    __m256i step = _mm256_loadu_si256((const __m256i *)(batch->step + first));
+    __m256i stopStep = _mm256_loadu_si256((const __m256i *)(batch->stopStep + first));
+    __m256i row = _mm256_loadu_si256((const __m256i *)(batch->row + first));
+    __m256i listIdx = _mm256_loadu_si256((const __m256i *)(batch->listIdx + first));
+    __m256i due = _mm256_loadu_si256((const __m256i *)(batch->due + first));
+    __m256i deadline = _mm256_loadu_si256((const __m256i *)(batch->deadline + first));
+    __m256i start = _mm256_loadu_si256((const __m256i *)(batch->start + first));
+    __m256i draws = _mm256_loadu_si256((const __m256i *)(batch->draws + first));
+    __m256i result = _mm256_loadu_si256((const __m256i *)(batch->result + first));
+    __m256i lastStop = _mm256_loadu_si256((const __m256i *)(batch->lastStop + first));
+    __m256i spinning = _mm256_loadu_si256((const __m256i *)(batch->spinning + first));
+    __m256i steps = _mm256_loadu_si256((const __m256i *)(batch->steps + first));
+
+    while (true)
+    {
+        // Roletas com o passo vencido: due - until <= 0
+        __m256i active = _mm256_xor_si256(_mm256_cmpgt_epi32(_mm256_sub_epi32(due, limit), zero), ones);
+        if(_mm256_testz_si256(active, active)) break;
+
+        __m256i time = _mm256_mask_i32gather_epi32(zero, batch->times, _mm256_add_epi32(row, step), active, 4);
+
+        // soft_timer_next(): atrasado (due - deadline >= time) recomeça de due, senão soma ao prazo
+        __m256i late = _mm256_xor_si256(_mm256_cmpgt_epi32(time, _mm256_sub_epi32(due, deadline)), ones);
+        __m256i next = _mm256_add_epi32(_mm256_blendv_epi8(deadline, due, late), time);
+        deadline = _mm256_blendv_epi8(deadline, next, active);
+        steps = _mm256_sub_epi32(steps, active);
+
+        __m256i stop = _mm256_and_si256(active, _mm256_cmpeq_epi32(step, stopStep));
+        __m256i move = _mm256_andnot_si256(stop, active);
+
+        __m256i led = _mm256_add_epi32(selectedLed, one);
+        led = _mm256_andnot_si256(_mm256_cmpeq_epi32(led, leds), led);
+        selectedLed = _mm256_blendv_epi8(selectedLed, led, move);
+        step = _mm256_sub_epi32(step, move);
+        due = _mm256_blendv_epi8(due, next, move);
+
+        if(_mm256_testz_si256(stop, stop)) continue;
+
+        result = _mm256_blendv_epi8(result, selectedLed, stop);
+        lastStop = _mm256_blendv_epi8(lastStop, due, stop);
+        draws = _mm256_sub_epi32(draws, stop);
+        spinning = _mm256_add_epi32(spinning, _mm256_and_si256(_mm256_sub_epi32(due, start), stop));
+
+        __m256i index = _mm256_add_epi32(listIdx, one);
+        index = _mm256_andnot_si256(_mm256_cmpeq_epi32(index, listSize), index);
+        listIdx = _mm256_blendv_epi8(listIdx, index, stop);
+
+        __m256i restart = _mm256_add_epi32(due, pause);
+        start = _mm256_blendv_epi8(start, restart, stop);
+        due = _mm256_blendv_epi8(due, restart, stop);
+        deadline = _mm256_blendv_epi8(deadline, _mm256_sub_epi32(restart, stopped), stop);
+
+        __m256i target = _mm256_mask_i32gather_epi32(zero, batch->numbers, _mm256_add_epi32(_mm256_mullo_epi32(listIdx, stride), lane), stop, 4);
+        __m256i pair = _mm256_add_epi32(_mm256_mullo_epi32(selectedLed, leds), target);
+        stopStep = _mm256_mask_i32gather_epi32(stopStep, batch->plans, pair, stop, 4);
+        row = _mm256_mask_i32gather_epi32(row, batch->rows, pair, stop, 4);
+        step = _mm256_andnot_si256(stop, step);
+    }
+
+    _mm256_storeu_si256((__m256i *)(batch->selectedLed + first), selectedLed);
+    _mm256_storeu_si256((__m256i *)(batch->step + first), step);
+    _mm256_storeu_si256((__m256i *)(batch->stopStep + first), stopStep);
+    _mm256_storeu_si256((__m256i *)(batch->row + first), row);
+    _mm256_storeu_si256((__m256i *)(batch->listIdx + first), listIdx);
+    _mm256_storeu_si256((__m256i *)(batch->due + first), due);
+    _mm256_storeu_si256((__m256i *)(batch->deadline + first), deadline);
+    _mm256_storeu_si256((__m256i *)(batch->start + first), start);
+    _mm256_storeu_si256((__m256i *)(batch->draws + first), draws);
+    _mm256_storeu_si256((__m256i *)(batch->result + first), result);
+    _mm256_storeu_si256((__m256i *)(batch->lastStop + first), lastStop);
+    _mm256_storeu_si256((__m256i *)(batch->spinning + first), spinning);
+    _mm256_storeu_si256((__m256i *)(batch->steps + first), steps);
+}
+#endif
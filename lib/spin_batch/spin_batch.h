@@ -0,0 +1,91 @@
+/**
+ * @file spin_batch.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Simulação em lote, no computador, dos sorteios de milhares de roletas com a mesma configuração
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * O estado das roletas fica em uma estrutura de vetores (um vetor por
+ * campo, uma posição por roleta), e cada roleta repete o ciclo: giro até o
+ * led sorteado, pausa de pause milissegundos (apostas), novo giro com o
+ * próximo número da sua lista. Os passos são os mesmos de
+ * ElectronicRoulette::drawing(): a duração de cada passo vem da tabela do
+ * spin_profile e o prazo avança pela regra de soft_timer_next(), então o
+ * led sorteado e o instante de cada parada são idênticos aos da roleta
+ * simulada sobre o shim da lib/hal.
+ *
+ * Compilado com AVX2 (-mavx2), spin_batch_run() avança 8 roletas por vez;
+ * sem AVX2 o mesmo cálculo é feito uma roleta por vez. Todos os campos têm
+ * 32 bits, e os tempos são millis(), com a mesma volta a cada ~49 dias.
+ * Somente para o computador: os vetores são alocados com malloc.
+ *
+ */
+
+#ifndef __SPINBATCH__H__
+#define __SPINBATCH__H__
+
+#include "hal.h"
+#include "spin_profile.h"
+
+#define SPIN_BATCH_LANES 8              //!< Roletas avançadas por vez (inteiros de 32 bits em um registrador AVX2)
+#define SPIN_BATCH_LIST_SIZE 24         //!< Tamanho da lista de números de cada roleta (como setNumbersList)
+
+/**
+ * @brief Configuração comum a todas as roletas do lote (ver os métodos set* da ElectronicRoulette)
+ */
+typedef struct
+{
+    uint8_t ledsCount;                  //!< Quantidade de leds
+    uint16_t time;                      //!< Duração do primeiro passo (roulette_speed_to_time)
+    uint8_t deceleration;               //!< Acréscimo de duração a cada passo
+    uint16_t stopDeceleration;          //!< Duração mínima de um passo para que a roleta possa parar
+    bool stopPlanner;                   //!< Giro planejado (setStopPlanner)
+    uint16_t spinTime;                  //!< Duração desejada do giro planejado (setSpinTime)
+    spin_easing_t easing;               //!< Curva de desaceleração (setEasing)
+    uint32_t pause;                     //!< Intervalo entre a parada e o início do próximo giro, em milissegundos
+}spin_batch_config_t;
+
+/**
+ * @brief Lote de roletas, com um vetor por campo
+ *
+ * A posição i de cada vetor pertence à roleta i. step é o passo atual do
+ * giro, o equivalente ao antigo totalDeceleration (passo x desaceleração).
+ * due é o instante em que a roleta executa o próximo passo, e deadline o
+ * prazo do temporizador dos passos, que só diferem durante a pausa.
+ */
+typedef struct
+{
+    uint32_t count;                     //!< Quantidade de roletas
+    uint32_t stride;                    //!< Tamanho alocado de cada vetor (count arredondado para SPIN_BATCH_LANES)
+    spin_batch_config_t config;         //!< Configuração das roletas
+    int32_t *selectedLed;               //!< Led selecionado
+    int32_t *step;                      //!< Passo atual do giro
+    int32_t *stopStep;                  //!< Passo em que o giro atual termina
+    int32_t *row;                       //!< Início, em times, da tabela de passos do giro atual
+    int32_t *listIdx;                   //!< Posição do número do giro atual na lista
+    int32_t *due;                       //!< Instante (millis) do próximo passo
+    int32_t *deadline;                  //!< Prazo do temporizador dos passos (soft_timer_t::deadline)
+    int32_t *start;                     //!< Instante em que o giro atual começou
+    int32_t *draws;                     //!< Sorteios concluídos
+    int32_t *result;                    //!< Led sorteado na última parada
+    int32_t *lastStop;                  //!< Instante da última parada
+    int32_t *spinning;                  //!< Tempo total girando, em milissegundos
+    int32_t *steps;                     //!< Passos executados
+    int32_t *numbers;                   //!< Listas de números (led, 0 a ledsCount - 1): posição k da roleta i em numbers[k * stride + i]
+    int32_t *times;                     //!< Duração de cada passo, uma tabela por passo de parada possível
+    int32_t *plans;                     //!< Passo de parada para cada par (led inicial, led sorteado)
+    int32_t *rows;                      //!< Início da tabela de passos para cada par (led inicial, led sorteado)
+    int32_t minStop;                    //!< Menor passo de parada possível
+    int32_t rowSize;                    //!< Tamanho de cada tabela de passos em times
+}spin_batch_t;
+
+bool spin_batch_init(spin_batch_t *batch, uint32_t count, const spin_batch_config_t *config);
+void spin_batch_free(spin_batch_t *batch);
+void spin_batch_set_numbers(spin_batch_t *batch, uint32_t wheel, const uint8_t numbers[SPIN_BATCH_LIST_SIZE]);
+void spin_batch_begin(spin_batch_t *batch, uint32_t wheel, uint32_t time);
+void spin_batch_run(spin_batch_t *batch, uint32_t until);
+bool spin_batch_has_avx2();
+
+#endif  //!__SPINBATCH__H__
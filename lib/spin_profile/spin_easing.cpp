@@ -0,0 +1,96 @@
+/**
+ * @file spin_easing.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Curvas de desaceleração do giro, em ponto fixo
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "spin_easing.h"
+
+#define SPIN_EASING_SEGMENT_BITS 10     //!< Bits de x dentro de cada segmento da tabela (32 segmentos em Q15)
+
+/**
+ * Tabelas das curvas (Q15, x = i / 32)
+ */
+
+//! (e^(3x) - 1) / (e^3 - 1)
+const uint16_t spin_easing_exponential[] PROGMEM = {
+    0, 169, 354, 558, 781, 1027, 1296, 1593, 1918, 2275, 2667,
+    3098, 3572, 4091, 4662, 5289, 5978, 6734, 7565, 8477, 9479, 10579,
+    11788, 13115, 14573, 16174, 17932, 19863, 21984, 24314, 26872, 29682, 32768
+};
+
+//! 1 - (1 - x)^3
+const uint16_t spin_easing_cubic[] PROGMEM = {
+    0, 2977, 5768, 8379, 10816, 13085, 15192, 17143, 18944, 20601, 22120,
+    23507, 24768, 25909, 26936, 27855, 28672, 29393, 30024, 30571, 31040, 31437,
+    31768, 32039, 32256, 32425, 32552, 32643, 32704, 32741, 32760, 32767, 32768
+};
+
+//! (1 - u) / (1 + 4u), u = sqrt(1 - x): velocidade de atrito constante, de 1 até 1/5
+const uint16_t spin_easing_friction[] PROGMEM = {
+    0, 105, 214, 327, 446, 571, 702, 839, 983, 1136, 1297,
+    1468, 1649, 1842, 2048, 2269, 2507, 2764, 3043, 3348, 3682, 4052,
+    4465, 4931, 5461, 6076, 6800, 7677, 8774, 10219, 12288, 15802, 32768
+};
+
+/**
+ * Funções Públicas
+ */
+
+/**
+ * @brief Avalia uma curva
+ * 
+ * @param easing Curva a ser avaliada
+ * @param x Progresso do giro em Q15 (0 a SPIN_EASING_ONE)
+ * @return uint16_t Fração do aumento da duração dos passos em Q15
+ */
+uint16_t spin_easing_eval(spin_easing_t easing, uint16_t x){
+    const uint16_t *table;
+
+    if(x >= SPIN_EASING_ONE) return SPIN_EASING_ONE;
+
+    switch (easing)
+    {
+    case SPIN_EASING_EXPONENTIAL:
+        table = spin_easing_exponential;
+        break;
+    case SPIN_EASING_CUBIC:
+        table = spin_easing_cubic;
+        break;
+    case SPIN_EASING_FRICTION:
+        table = spin_easing_friction;
+        break;
+    default:
+        return x;
+    }
+
+    uint8_t segment = x >> SPIN_EASING_SEGMENT_BITS;
+    uint16_t fraction = x & ((1 << SPIN_EASING_SEGMENT_BITS) - 1);
+    uint16_t a = pgm_read_word(&table[segment]);
+    uint16_t b = pgm_read_word(&table[segment + 1]);
+
+    return a + (((uint32_t)(b - a) * fraction) >> SPIN_EASING_SEGMENT_BITS);
+}
+
+/**
+ * @brief Calcula o aumento da duração de um passo
+ * @note Na curva linear o resultado é exatamente span * step / steps, arredondado
+ * 
+ * @param easing Curva utilizada
+ * @param step Índice do passo
+ * @param steps Passo em que o aumento atinge span (maior que 0)
+ * @param span Aumento total da duração dos passos, em milissegundos
+ * @return uint16_t Aumento da duração do passo em relação ao primeiro passo
+ */
+uint16_t spin_easing_scale(spin_easing_t easing, uint16_t step, uint16_t steps, uint32_t span){
+    if(step >= steps) return span;
+    if(easing == SPIN_EASING_LINEAR) return (span * step + steps / 2) / steps;
+
+    uint16_t x = ((uint32_t)step << 15) / steps;
+    return (span * spin_easing_eval(easing, x) + SPIN_EASING_ONE / 2) >> 15;
+}
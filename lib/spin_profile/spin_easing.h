@@ -0,0 +1,39 @@
+/**
+ * @file spin_easing.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Curvas de desaceleração do giro, em ponto fixo
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * As curvas levam o progresso do giro (0 a 1) à fração do aumento total na
+ * duração dos passos (0 a 1), ambos em Q15. As curvas não lineares são
+ * tabelas em PROGMEM com 32 segmentos, interpoladas linearmente, sem
+ * nenhuma operação em ponto flutuante.
+ * 
+ */
+
+#ifndef __SPINEASING__H__
+#define __SPINEASING__H__
+
+#include "hal.h"
+
+#define SPIN_EASING_ONE 32768           //!< Valor 1,0 em Q15
+
+/**
+ * @brief Curvas de desaceleração disponíveis
+ */
+typedef enum
+{
+    SPIN_EASING_LINEAR,                 //!< Aumento constante da duração dos passos (comportamento original)
+    SPIN_EASING_EXPONENTIAL,            //!< Duração cresce exponencialmente: gira rápido por mais tempo e freia no final
+    SPIN_EASING_CUBIC,                  //!< Cúbica ease-out: freia forte no início e chega suavemente à velocidade de parada
+    SPIN_EASING_FRICTION,               //!< Atrito constante (v² cai linearmente com a distância), tabelado para parada 5x mais lenta que a partida
+    SPIN_EASING_COUNT                   //!< Quantidade de curvas
+}spin_easing_t;
+
+uint16_t spin_easing_eval(spin_easing_t easing, uint16_t x);
+uint16_t spin_easing_scale(spin_easing_t easing, uint16_t step, uint16_t steps, uint32_t span);
+
+#endif  //!__SPINEASING__H__
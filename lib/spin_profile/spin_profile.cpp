@@ -0,0 +1,149 @@
+/**
+ * @file spin_profile.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Duração de cada passo do giro da roleta, calculada a partir da configuração
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "spin_profile.h"
+
+/**
+ * Funções Públicas
+ */
+
+/**
+ * @brief Calcula o perfil do giro a partir da configuração
+ * 
+ * @param profile Perfil a ser calculado
+ * @param time Duração do primeiro passo, em milissegundos
+ * @param deceleration Acréscimo de duração a cada passo
+ * @param stopDeceleration Duração mínima de um passo para que a roleta possa parar
+ * @param ledsCount Quantidade de leds da roleta
+ * @param easing Curva de desaceleração até o passo de parada
+ */
+void spin_profile_build(spin_profile_t *profile, uint16_t time, uint8_t deceleration, uint16_t stopDeceleration, uint8_t ledsCount, spin_easing_t easing){
+    profile->time = time;
+    profile->deceleration = deceleration;
+    profile->stopDeceleration = stopDeceleration;
+    profile->ledsCount = ledsCount;
+    profile->easing = easing;
+    profile->planned = false;
+    profile->lastStep = 0;
+    profile->settleStep = SPIN_PROFILE_ENDLESS;
+
+    if(time >= stopDeceleration){
+        profile->settleStep = 0;
+    }else if(deceleration > 0){
+        uint32_t settle = ((uint32_t)(stopDeceleration - time) + deceleration - 1) / deceleration;
+        if(settle < SPIN_PROFILE_ENDLESS - 0xFF) profile->settleStep = settle;
+    }
+}
+
+/**
+ * @brief Planeja um giro que termina na velocidade de parada exatamente sobre o led sorteado
+ * @note Substitui o giro planejado anteriormente. O perfil deve ter sido calculado por spin_profile_build().
+ * Quando o giro não pode ser planejado (ex.: velocidade inicial já abaixo da de parada), volta ao giro linear
+ * 
+ * A quantidade nominal de passos vem de spinTime ou, se spinTime for 0, do
+ * passo em que a desaceleração configurada atinge a velocidade de parada.
+ * O último passo é ajustado para o valor mais próximo que cai sobre o led
+ * sorteado (no máximo meia volta de diferença), e a duração dos passos é
+ * interpolada pela curva entre time e stopDeceleration. Assim não existe a volta extra
+ * na velocidade mínima esperando o led sorteado. Um giro planejado sempre
+ * termina: spinTime é limitado a SPIN_PROFILE_MAX_SPIN_TIME, e o último passo,
+ * a um valor finito sobre o mesmo led.
+ * 
+ * @param profile Perfil do giro
+ * @param spinTime Duração desejada do giro em milissegundos (0 = definida pela desaceleração)
+ * @param startLed Led selecionado no primeiro passo
+ * @param target Led sorteado (0 a ledsCount - 1)
+ * @return uint16_t Índice do último passo, ou SPIN_PROFILE_ENDLESS se spinTime é 0 e a desaceleração nunca atinge a velocidade de parada
+ */
+uint16_t spin_profile_plan(spin_profile_t *profile, uint16_t spinTime, uint8_t startLed, uint8_t target){
+    uint32_t nominal;
+
+    profile->planned = false;
+    profile->lastStep = 0;
+
+    if(target >= profile->ledsCount || profile->time >= profile->stopDeceleration){
+        return spin_profile_stop_step(profile, startLed, target);
+    }
+
+    if(spinTime > SPIN_PROFILE_MAX_SPIN_TIME) spinTime = SPIN_PROFILE_MAX_SPIN_TIME;
+    if(spinTime > 0){
+        nominal = ((uint32_t)spinTime * 2 + (profile->time + profile->stopDeceleration) / 2) / (profile->time + profile->stopDeceleration);
+    }else if(profile->settleStep != SPIN_PROFILE_ENDLESS){
+        nominal = profile->settleStep;
+    }else{
+        return SPIN_PROFILE_ENDLESS;
+    }
+
+    uint8_t nominalLed = (startLed + nominal) % profile->ledsCount;
+    uint8_t distance = (target + profile->ledsCount - nominalLed) % profile->ledsCount;
+    uint32_t lastStep = nominal + distance;
+
+    if(distance > profile->ledsCount / 2 && lastStep >= profile->ledsCount) lastStep -= profile->ledsCount;
+    if(lastStep == 0) lastStep = profile->ledsCount;
+    while (lastStep >= SPIN_PROFILE_ENDLESS) lastStep -= profile->ledsCount;
+
+    profile->planned = true;
+    profile->lastStep = lastStep;
+    return lastStep;
+}
+
+/**
+ * @brief Calcula em qual passo o giro termina
+ * 
+ * @param profile Perfil do giro
+ * @param startLed Led selecionado no primeiro passo
+ * @param target Led sorteado (0 a ledsCount - 1)
+ * @return uint16_t Índice do último passo, ou SPIN_PROFILE_ENDLESS se o giro nunca termina
+ */
+uint16_t spin_profile_stop_step(const spin_profile_t *profile, uint8_t startLed, uint8_t target){
+    if(profile->settleStep == SPIN_PROFILE_ENDLESS || target >= profile->ledsCount) return SPIN_PROFILE_ENDLESS;
+
+    uint8_t settleLed = (startLed + profile->settleStep) % profile->ledsCount;
+    uint8_t distance = (target + profile->ledsCount - settleLed) % profile->ledsCount;
+    return profile->settleStep + distance;
+}
+
+/**
+ * @brief Obtém a duração de um passo do giro
+ * 
+ * @param profile Perfil do giro
+ * @param step Índice do passo
+ * @return uint16_t Duração do passo, em milissegundos
+ */
+uint16_t spin_profile_step_time(const spin_profile_t *profile, uint16_t step){
+    if(profile->planned){
+        return profile->time + spin_easing_scale(profile->easing, step, profile->lastStep, profile->stopDeceleration - profile->time);
+    }
+    if(profile->easing == SPIN_EASING_LINEAR || profile->settleStep == SPIN_PROFILE_ENDLESS || step >= profile->settleStep){
+        return profile->time + (uint16_t)(step * profile->deceleration);
+    }
+    return profile->time + spin_easing_scale(profile->easing, step, profile->settleStep, (uint32_t)profile->settleStep * profile->deceleration);
+}
+
+/**
+ * @brief Calcula a duração de um giro, do primeiro passo até o led sorteado acender
+ * @note A duração do último passo não é somada, pois a roleta para ao entrar nele
+ * 
+ * @param profile Perfil do giro
+ * @param stopStep Índice do último passo (ver spin_profile_stop_step)
+ * @return uint32_t Duração em milissegundos, ou SPIN_PROFILE_ENDLESS_TIME se o giro nunca termina
+ */
+uint32_t spin_profile_duration(const spin_profile_t *profile, uint16_t stopStep){
+    uint32_t total = 0;
+
+    if(stopStep == SPIN_PROFILE_ENDLESS) return SPIN_PROFILE_ENDLESS_TIME;
+
+    for (uint32_t step = 0; step < stopStep; step++)
+    {
+        total += spin_profile_step_time(profile, step);
+    }
+    return total;
+}
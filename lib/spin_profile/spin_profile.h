@@ -0,0 +1,58 @@
+/**
+ * @file spin_profile.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Duração de cada passo do giro da roleta, calculada a partir da configuração
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#ifndef __SPINPROFILE__H__
+#define __SPINPROFILE__H__
+
+#include "hal.h"
+#include "spin_easing.h"
+
+#define SPIN_PROFILE_ENDLESS 0xFFFF             //!< Índice de parada de um giro que nunca termina (ex.: desaceleração 0)
+#define SPIN_PROFILE_ENDLESS_TIME 0xFFFFFFFF    //!< Duração de um giro que nunca termina
+#define SPIN_PROFILE_MAX_SPIN_TIME 60000        //!< Maior duração aceita para o giro planejado, em milissegundos
+
+/**
+ * @brief Perfil do giro: duração de cada passo e o passo a partir do qual a roleta pode parar
+ * 
+ * Na curva linear o passo k dura time + k * deceleration. As demais curvas
+ * distribuem o mesmo aumento de duração até o passo de parada de outra
+ * forma e, depois dele, a duração volta a crescer deceleration por passo.
+ * A roleta pode parar a partir do
+ * primeiro passo com duração maior ou igual a stopDeceleration (settleStep),
+ * no primeiro passo em que o led selecionado for o led sorteado.
+ * 
+ * Depois de spin_profile_plan() o giro é planejado: a duração dos passos é
+ * interpolada pela curva, de time até stopDeceleration, de forma que o último passo,
+ * já na velocidade de parada, caia exatamente no led sorteado.
+ *
+ * A duração de cada passo é calculada quando o passo é executado, sem uma
+ * tabela por roleta: o perfil ocupa poucos bytes da RAM do ATmega328P, e as
+ * curvas ficam nas tabelas da memória de programa (spin_easing).
+ */
+typedef struct
+{
+    uint16_t time;                              //!< Duração do primeiro passo
+    uint8_t deceleration;                       //!< Acréscimo de duração a cada passo
+    uint16_t settleStep;                        //!< Primeiro passo com duração de parada (SPIN_PROFILE_ENDLESS se nunca ocorre)
+    uint16_t stopDeceleration;                  //!< Duração mínima de um passo para que a roleta possa parar
+    uint8_t ledsCount;                          //!< Quantidade de leds da roleta
+    spin_easing_t easing;                       //!< Curva de desaceleração
+    bool planned;                               //!< Indica se o perfil contém um giro planejado por spin_profile_plan()
+    uint16_t lastStep;                          //!< Último passo do giro planejado
+}spin_profile_t;
+
+void spin_profile_build(spin_profile_t *profile, uint16_t time, uint8_t deceleration, uint16_t stopDeceleration, uint8_t ledsCount, spin_easing_t easing);
+uint16_t spin_profile_plan(spin_profile_t *profile, uint16_t spinTime, uint8_t startLed, uint8_t target);
+uint16_t spin_profile_stop_step(const spin_profile_t *profile, uint8_t startLed, uint8_t target);
+uint16_t spin_profile_step_time(const spin_profile_t *profile, uint16_t step);
+uint32_t spin_profile_duration(const spin_profile_t *profile, uint16_t stopStep);
+
+#endif  //!__SPINPROFILE__H__
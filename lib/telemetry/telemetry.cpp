@@ -0,0 +1,377 @@
+/**
+ * @file telemetry.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Telemetria binária dos leds e do estado das roletas, enviada apenas quando algo muda
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include <string.h>
+#include "telemetry.h"
+
+/**
+ * Variáveis globais
+ */
+HAL_THREAD_LOCAL uint8_t telemetry_tx[TELEMETRY_TX_SIZE];    //!< Buffer circular de transmissão
+HAL_THREAD_LOCAL uint8_t telemetry_head = 0;                 //!< Próxima posição a ser escrita no buffer
+HAL_THREAD_LOCAL uint8_t telemetry_tail = 0;                 //!< Próxima posição a ser enviada para a serial
+HAL_THREAD_LOCAL uint8_t telemetry_epoch = 0;                //!< Incrementado por telemetry_resync(), para que todos os canais enviem TELEMETRY_SYNC
+HAL_THREAD_LOCAL uint32_t telemetry_time = 0;                //!< Instante (millis) da última mensagem colocada no buffer
+HAL_THREAD_LOCAL uint32_t telemetry_dropped_total = 0;       //!< Mudanças descartadas por todos os canais
+
+/**
+ * Protótipos das funções privadas
+ */
+bool telemetry_push(const uint8_t *data, uint8_t size);
+uint8_t telemetry_put_varint(uint8_t *data, uint32_t value);
+uint8_t telemetry_frame_bytes(const telemetry_channel_t *channel);
+uint8_t telemetry_header(uint8_t *data, telemetry_type_t type, const telemetry_channel_t *channel, uint32_t now);
+bool telemetry_send_sync(telemetry_channel_t *channel);
+bool telemetry_send_dropped(telemetry_channel_t *channel);
+bool telemetry_send_state(telemetry_channel_t *channel);
+bool telemetry_send_frame(telemetry_channel_t *channel);
+
+/**
+ * Funções Públicas
+ */
+
+/**
+ * @brief Esvazia o buffer de transmissão
+ * 
+ */
+void telemetry_init(){
+    telemetry_head = 0;
+    telemetry_tail = 0;
+    telemetry_dropped_total = 0;
+    telemetry_resync();
+}
+
+/**
+ * @brief Faz todos os canais enviarem TELEMETRY_SYNC na próxima mensagem
+ * @note Utilizada pelo comando sync, e depois que outros dados foram enviados pela serial no meio da telemetria
+ * 
+ */
+void telemetry_resync(){
+    telemetry_epoch++;
+}
+
+/**
+ * @brief Passa os bytes do buffer de transmissão para a serial, sem bloquear. Deve ser chamada no loop
+ * 
+ * @return true Se o buffer de transmissão ficou vazio
+ */
+bool telemetry_flush(){
+    while (telemetry_tail != telemetry_head && Serial.availableForWrite() > 0)
+    {
+        Serial.write(telemetry_tx[telemetry_tail]);
+        telemetry_tail = (telemetry_tail + 1) & (TELEMETRY_TX_SIZE - 1);
+    }
+    return telemetry_tail == telemetry_head;
+}
+
+/**
+ * @brief Antecipa o prazo do loop enquanto houver bytes aguardando espaço na serial
+ * 
+ * @param deadline Instante (millis) em que a aplicação precisa ser atualizada
+ * @return uint32_t deadline, ou no máximo TELEMETRY_FLUSH_TIME a partir de agora se o buffer de transmissão não está vazio
+ */
+uint32_t telemetry_deadline(uint32_t deadline){
+    uint32_t flush = millis() + TELEMETRY_FLUSH_TIME;
+
+    if(telemetry_tail != telemetry_head && (int32_t)(deadline - flush) > 0) return flush;
+    return deadline;
+}
+
+/**
+ * @brief Obtém a quantidade de mudanças descartadas por falta de espaço na transmissão
+ * 
+ * @return uint32_t Mudanças descartadas desde telemetry_init()
+ */
+uint32_t telemetry_dropped(){
+    return telemetry_dropped_total;
+}
+
+/**
+ * @brief Obtém o espaço livre no buffer de transmissão
+ * 
+ * @return uint8_t Bytes livres
+ */
+uint8_t telemetry_space(){
+    return (TELEMETRY_TX_SIZE - 1) - ((telemetry_head - telemetry_tail) & (TELEMETRY_TX_SIZE - 1));
+}
+
+/**
+ * @brief Envia uma mensagem que não pertence a uma roleta (TELEMETRY_REPLY ou TELEMETRY_TRACE)
+ * 
+ * @param type Tipo da mensagem
+ * @param data Conteúdo da mensagem
+ * @param size Tamanho do conteúdo (até TELEMETRY_TX_SIZE - 8)
+ * @return true Se a mensagem coube no buffer de transmissão. Caso contrário nada é escrito
+ */
+bool telemetry_send(telemetry_type_t type, const uint8_t *data, uint8_t size){
+    uint8_t header[7];
+    uint32_t now = millis();
+    uint8_t headerSize = 1;
+
+    header[0] = (type << 4) | TELEMETRY_SOURCE_HOST;
+    headerSize += telemetry_put_varint(&header[1], now - telemetry_time);
+    header[headerSize++] = size;
+    if((uint16_t)headerSize + size > telemetry_space()) return false;
+
+    telemetry_push(header, headerSize);
+    telemetry_push(data, size);
+    telemetry_time = now;
+    return true;
+}
+
+/**
+ * @brief Inicializa o canal de uma roleta. A primeira mensagem do canal será TELEMETRY_SYNC
+ * 
+ * @param channel Canal
+ * @param source Número do canal (0 a 15)
+ * @param ledsCount Quantidade de leds da roleta
+ * @param state Estado atual da roleta
+ */
+void telemetry_channel_init(telemetry_channel_t *channel, uint8_t source, uint8_t ledsCount, uint8_t state){
+    channel->source = source & 0x0F;
+    channel->ledsCount = ledsCount;
+    bits_frame_clear(&channel->frame);
+    bits_frame_clear(&channel->sent);
+    channel->state = state;
+    channel->sentState = state;
+    channel->dropped = 0;
+    channel->epoch = telemetry_epoch - 1;
+    channel->syncTime = 0;
+}
+
+/**
+ * @brief Altera a quantidade de leds do canal. A próxima mensagem do canal será TELEMETRY_SYNC
+ * 
+ * @param channel Canal
+ * @param ledsCount Nova quantidade de leds da roleta
+ */
+void telemetry_channel_set_leds(telemetry_channel_t *channel, uint8_t ledsCount){
+    channel->ledsCount = ledsCount;
+    channel->epoch = telemetry_epoch - 1;
+}
+
+/**
+ * @brief Informa o quadro escrito nos leds e tenta enviá-lo
+ * 
+ * @param channel Canal
+ * @param frame Quadro escrito
+ */
+void telemetry_channel_frame(telemetry_channel_t *channel, const bits_frame_t *frame){
+    if(bits_frame_equal(&channel->frame, frame)) return;
+
+    if(!bits_frame_equal(&channel->frame, &channel->sent) && channel->dropped < 0xFFFF){
+        channel->dropped++;
+        telemetry_dropped_total++;
+    }
+    channel->frame = *frame;
+    telemetry_channel_flush(channel);
+}
+
+/**
+ * @brief Informa o novo estado da roleta e tenta enviá-lo
+ * 
+ * @param channel Canal
+ * @param state Novo estado
+ */
+void telemetry_channel_state(telemetry_channel_t *channel, uint8_t state){
+    if(channel->state == state) return;
+
+    if(channel->state != channel->sentState && channel->dropped < 0xFFFF){
+        channel->dropped++;
+        telemetry_dropped_total++;
+    }
+    channel->state = state;
+    telemetry_channel_flush(channel);
+}
+
+/**
+ * @brief Coloca no buffer de transmissão as mudanças pendentes do canal, enquanto houver espaço
+ * @note Chamada também periodicamente (ex.: em task()), para enviar o que ficou pendente e os TELEMETRY_SYNC
+ * 
+ * @param channel Canal
+ */
+void telemetry_channel_flush(telemetry_channel_t *channel){
+    if(channel->epoch != telemetry_epoch || (uint32_t)(millis() - channel->syncTime) >= TELEMETRY_SYNC_TIME){
+        telemetry_send_sync(channel);
+        return;
+    }
+    if(channel->dropped && !telemetry_send_dropped(channel)) return;
+    if(channel->state != channel->sentState && !telemetry_send_state(channel)) return;
+    if(!bits_frame_equal(&channel->frame, &channel->sent)) telemetry_send_frame(channel);
+}
+
+/**
+ * Funções privadas
+ */
+
+/**
+ * @brief Coloca uma mensagem inteira no buffer de transmissão
+ * 
+ * @param data Mensagem
+ * @param size Tamanho da mensagem
+ * @return true Se a mensagem coube no buffer. Caso contrário nada é escrito
+ */
+bool telemetry_push(const uint8_t *data, uint8_t size){
+    if(size > telemetry_space()) return false;
+
+    for (uint8_t i = 0; i < size; i++)
+    {
+        telemetry_tx[telemetry_head] = data[i];
+        telemetry_head = (telemetry_head + 1) & (TELEMETRY_TX_SIZE - 1);
+    }
+    return true;
+}
+
+/**
+ * @brief Escreve um varint
+ * 
+ * @param data Destino (até 5 bytes)
+ * @param value Valor
+ * @return uint8_t Quantidade de bytes escritos
+ */
+uint8_t telemetry_put_varint(uint8_t *data, uint32_t value){
+    uint8_t size = 0;
+
+    while (value >= 0x80)
+    {
+        data[size++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    data[size++] = value;
+    return size;
+}
+
+/**
+ * @brief Obtém a quantidade de bytes do quadro da roleta do canal
+ * 
+ * @param channel Canal
+ * @return uint8_t Bytes do quadro
+ */
+uint8_t telemetry_frame_bytes(const telemetry_channel_t *channel){
+    uint8_t bytes = (channel->ledsCount + 7) / 8;
+    return bytes > TELEMETRY_FRAME_BYTES ? TELEMETRY_FRAME_BYTES : bytes;
+}
+
+/**
+ * @brief Escreve o cabeçalho e o tempo desde a mensagem anterior
+ * 
+ * @param data Destino
+ * @param type Tipo da mensagem
+ * @param channel Canal
+ * @param now Instante (millis) da mensagem
+ * @return uint8_t Quantidade de bytes escritos
+ */
+uint8_t telemetry_header(uint8_t *data, telemetry_type_t type, const telemetry_channel_t *channel, uint32_t now){
+    data[0] = (type << 4) | channel->source;
+    return 1 + telemetry_put_varint(&data[1], now - telemetry_time);
+}
+
+/**
+ * @brief Envia o estado completo do canal
+ * 
+ * @param channel Canal
+ * @return true Se a mensagem coube no buffer de transmissão
+ */
+bool telemetry_send_sync(telemetry_channel_t *channel){
+    uint8_t message[TELEMETRY_MESSAGE_MAX];
+    uint8_t bytes = telemetry_frame_bytes(channel);
+    uint8_t size = TELEMETRY_MAGIC_SIZE;
+    uint32_t now = millis();
+
+    memcpy(message, TELEMETRY_MAGIC, TELEMETRY_MAGIC_SIZE);
+    message[size++] = (TELEMETRY_SYNC << 4) | channel->source;
+    size += telemetry_put_varint(&message[size], now);
+    message[size++] = channel->ledsCount;
+    message[size++] = channel->state;
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        message[size++] = bits_frame_get_byte(&channel->frame, i * 8);
+    }
+
+    if(!telemetry_push(message, size)) return false;
+
+    telemetry_time = now;
+    channel->sent = channel->frame;
+    channel->sentState = channel->state;
+    channel->dropped = 0;
+    channel->epoch = telemetry_epoch;
+    channel->syncTime = now;
+    return true;
+}
+
+/**
+ * @brief Envia a quantidade de mudanças descartadas do canal
+ * 
+ * @param channel Canal
+ * @return true Se a mensagem coube no buffer de transmissão
+ */
+bool telemetry_send_dropped(telemetry_channel_t *channel){
+    uint8_t message[TELEMETRY_MESSAGE_MAX];
+    uint32_t now = millis();
+    uint8_t size = telemetry_header(message, TELEMETRY_DROPPED, channel, now);
+
+    size += telemetry_put_varint(&message[size], channel->dropped);
+    if(!telemetry_push(message, size)) return false;
+
+    telemetry_time = now;
+    channel->dropped = 0;
+    return true;
+}
+
+/**
+ * @brief Envia o estado mais recente do canal
+ * 
+ * @param channel Canal
+ * @return true Se a mensagem coube no buffer de transmissão
+ */
+bool telemetry_send_state(telemetry_channel_t *channel){
+    uint8_t message[TELEMETRY_MESSAGE_MAX];
+    uint32_t now = millis();
+    uint8_t size = telemetry_header(message, TELEMETRY_STATE, channel, now);
+
+    message[size++] = channel->state;
+    if(!telemetry_push(message, size)) return false;
+
+    telemetry_time = now;
+    channel->sentState = channel->state;
+    return true;
+}
+
+/**
+ * @brief Envia os bytes do quadro mais recente que diferem do último quadro enviado
+ * 
+ * @param channel Canal
+ * @return true Se a mensagem coube no buffer de transmissão
+ */
+bool telemetry_send_frame(telemetry_channel_t *channel){
+    uint8_t message[TELEMETRY_MESSAGE_MAX];
+    uint8_t bytes = telemetry_frame_bytes(channel);
+    uint8_t maskBytes = (bytes + 7) / 8;
+    uint32_t now = millis();
+    uint8_t size = telemetry_header(message, TELEMETRY_FRAME, channel, now);
+    uint8_t mask = size;
+
+    memset(&message[mask], 0, maskBytes);
+    size += maskBytes;
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        uint8_t delta = bits_frame_get_byte(&channel->frame, i * 8) ^ bits_frame_get_byte(&channel->sent, i * 8);
+        if(delta == 0) continue;
+
+        message[mask + i / 8] |= 1 << (i % 8);
+        message[size++] = delta;
+    }
+    if(!telemetry_push(message, size)) return false;
+
+    telemetry_time = now;
+    channel->sent = channel->frame;
+    return true;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file telemetry.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Telemetria binária dos leds e do estado das roletas, enviada apenas quando algo muda
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * As mensagens são montadas em um buffer circular na RAM e passadas para a
+ * serial por telemetry_flush() somente enquanto há espaço no buffer de
+ * transmissão, então o loop nunca bloqueia esperando a serial. Quando o
+ * buffer circular enche, a mudança fica pendente no canal da roleta e as
+ * mudanças seguintes a substituem: somente o estado mais recente é enviado,
+ * precedido por uma mensagem TELEMETRY_DROPPED com a quantidade de mudanças
+ * descartadas.
+ * 
+ * Formato de cada mensagem (decodificado por tools/telemetry_decode):
+ * - cabeçalho: tipo nos 4 bits mais significativos, canal (roleta) nos 4 menos significativos
+ * - TELEMETRY_SYNC: precedido por TELEMETRY_MAGIC. millis() completo (varint), quantidade de leds, estado e o quadro inteiro
+ * - TELEMETRY_FRAME: ms desde a mensagem anterior (varint), máscara dos bytes alterados e o XOR de cada byte alterado
+ * - TELEMETRY_STATE: ms desde a mensagem anterior (varint) e o novo estado
+ * - TELEMETRY_DROPPED: ms desde a mensagem anterior (varint) e a quantidade de mudanças descartadas (varint)
+ * - TELEMETRY_REPLY e TELEMETRY_TRACE: ms desde a mensagem anterior (varint), tamanho e os bytes da mensagem.
+ *   Não pertencem a uma roleta: o canal é sempre TELEMETRY_SOURCE_HOST
+ * 
+ * Os varints guardam 7 bits por byte, do menos para o mais significativo,
+ * com o bit 7 indicando que há mais bytes.
+ * 
+ */
+
+#ifndef __TELEMETRY__H__
+#define __TELEMETRY__H__
+
+#include "hal.h"
+#include "bits_frame.h"
+
+#ifndef TELEMETRY_TX_SIZE
+#define TELEMETRY_TX_SIZE 128           //!< Tamanho do buffer circular de transmissão (potência de 2, até 256)
+#endif
+
+#define TELEMETRY_MAGIC "TLM"           //!< Início de cada mensagem TELEMETRY_SYNC, utilizado pelo decodificador para se sincronizar
+#define TELEMETRY_MAGIC_SIZE 3          //!< Tamanho de TELEMETRY_MAGIC
+#define TELEMETRY_SOURCE_HOST 0x0F      //!< Canal das mensagens que não pertencem a uma roleta (respostas e registros do trace)
+#define TELEMETRY_FLUSH_TIME 10         //!< Intervalo máximo de sono enquanto há bytes aguardando espaço na serial, em milissegundos
+#define TELEMETRY_SYNC_TIME 2000        //!< Intervalo entre as mensagens TELEMETRY_SYNC de cada canal, em milissegundos
+#define TELEMETRY_FRAME_BYTES ((FRAME_MAX_BITS + 7) / 8)                                        //!< Bytes do maior quadro
+#define TELEMETRY_MESSAGE_MAX (11 + TELEMETRY_FRAME_BYTES + (TELEMETRY_FRAME_BYTES + 7) / 8)    //!< Tamanho da maior mensagem
+
+/**
+ * @brief Tipos de mensagem
+ */
+typedef enum
+{
+    TELEMETRY_SYNC = 1,                 //!< Estado completo do canal
+    TELEMETRY_FRAME,                    //!< Bytes do quadro que mudaram
+    TELEMETRY_STATE,                    //!< Novo estado da roleta
+    TELEMETRY_DROPPED,                  //!< Mudanças descartadas por falta de espaço na transmissão
+    TELEMETRY_REPLY = 6,                //!< Resposta a um comando recebido pela serial (texto). O tipo 5 não é utilizado, pois 0x5? inclui o 'T' de TELEMETRY_MAGIC
+    TELEMETRY_TRACE                     //!< Registro do gravador de eventos (8 bytes, ver trace_pack)
+}telemetry_type_t;
+
+/**
+ * @brief Canal de telemetria de uma roleta
+ */
+typedef struct
+{
+    uint8_t source;                     //!< Número do canal (0 a 15)
+    uint8_t ledsCount;                  //!< Quantidade de leds da roleta
+    bits_frame_t frame;                 //!< Quadro mais recente
+    bits_frame_t sent;                  //!< Último quadro colocado no buffer de transmissão
+    uint8_t state;                      //!< Estado mais recente
+    uint8_t sentState;                  //!< Último estado colocado no buffer de transmissão
+    uint16_t dropped;                   //!< Mudanças substituídas antes de serem enviadas
+    uint8_t epoch;                      //!< Valor de telemetry_epoch no último TELEMETRY_SYNC do canal
+    uint32_t syncTime;                  //!< Instante (millis) do último TELEMETRY_SYNC do canal
+}telemetry_channel_t;
+
+void telemetry_init();
+void telemetry_resync();
+bool telemetry_flush();
+uint32_t telemetry_deadline(uint32_t deadline);
+uint32_t telemetry_dropped();
+uint8_t telemetry_space();
+bool telemetry_send(telemetry_type_t type, const uint8_t *data, uint8_t size);
+void telemetry_channel_init(telemetry_channel_t *channel, uint8_t source, uint8_t ledsCount, uint8_t state);
+void telemetry_channel_set_leds(telemetry_channel_t *channel, uint8_t ledsCount);
+void telemetry_channel_frame(telemetry_channel_t *channel, const bits_frame_t *frame);
+void telemetry_channel_state(telemetry_channel_t *channel, uint8_t state);
+void telemetry_channel_flush(telemetry_channel_t *channel);
+
+#endif  //!__TELEMETRY__H__
@@ -0,0 +1,119 @@
+/**
+ * @file timer_wheel.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Roda de temporização (timer wheel) para agendar várias tarefas em um único loop
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "timer_wheel.h"
+
+/**
+ * Funções Públicas
+ */
+
+/**
+ * @brief Inicializa a roda, sem tarefas agendadas
+ * 
+ * @param wheel Roda de temporização
+ */
+void timer_wheel_init(timer_wheel_t *wheel){
+    for (uint8_t s = 0; s < TIMER_WHEEL_SLOTS; s++)
+    {
+        wheel->slots[s] = 0;
+    }
+    wheel->scheduled = 0;
+    wheel->tick = millis() >> TIMER_WHEEL_TICK_SHIFT;
+}
+
+/**
+ * @brief Agenda (ou reagenda) uma tarefa
+ * 
+ * @param wheel Roda de temporização
+ * @param task Índice da tarefa (0 a TIMER_WHEEL_MAX_TASKS - 1)
+ * @param deadline Instante (millis) em que a tarefa deve ser executada. Prazos passados expiram na próxima verificação
+ */
+void timer_wheel_schedule(timer_wheel_t *wheel, uint8_t task, uint32_t deadline){
+    if(task >= TIMER_WHEEL_MAX_TASKS) return;
+
+    timer_wheel_cancel(wheel, task);
+
+    uint32_t tick = deadline >> TIMER_WHEEL_TICK_SHIFT;
+    if((int32_t)(tick - wheel->tick) < 0) tick = wheel->tick;
+
+    wheel->deadlines[task] = deadline;
+    wheel->slots[tick & (TIMER_WHEEL_SLOTS - 1)] |= 1 << task;
+    wheel->scheduled |= 1 << task;
+}
+
+/**
+ * @brief Remove uma tarefa da roda
+ * 
+ * @param wheel Roda de temporização
+ * @param task Índice da tarefa
+ */
+void timer_wheel_cancel(timer_wheel_t *wheel, uint8_t task){
+    if(task >= TIMER_WHEEL_MAX_TASKS) return;
+
+    for (uint8_t s = 0; s < TIMER_WHEEL_SLOTS; s++)
+    {
+        wheel->slots[s] &= ~(1 << task);
+    }
+    wheel->scheduled &= ~(1 << task);
+}
+
+/**
+ * @brief Retira da roda as tarefas cujo prazo já chegou
+ * 
+ * @param wheel Roda de temporização
+ * @return uint8_t Tarefas a serem executadas (bit n = tarefa n)
+ */
+uint8_t timer_wheel_expire(timer_wheel_t *wheel){
+    uint32_t now = millis();
+    uint32_t nowTick = now >> TIMER_WHEEL_TICK_SHIFT;
+    uint32_t ticks = nowTick - wheel->tick;
+    uint8_t expired = 0;
+
+    if(ticks >= TIMER_WHEEL_SLOTS) ticks = TIMER_WHEEL_SLOTS - 1;
+
+    for (uint32_t t = nowTick - ticks; t != nowTick + 1; t++)
+    {
+        uint8_t slot = t & (TIMER_WHEEL_SLOTS - 1);
+        uint8_t tasks = wheel->slots[slot];
+
+        for (uint8_t task = 0; tasks; task++, tasks >>= 1)
+        {
+            if((tasks & 1) && (int32_t)(now - wheel->deadlines[task]) >= 0){
+                wheel->slots[slot] &= ~(1 << task);
+                expired |= 1 << task;
+            }
+        }
+    }
+
+    wheel->tick = nowTick;
+    wheel->scheduled &= ~expired;
+    return expired;
+}
+
+/**
+ * @brief Obtém o prazo mais próximo entre as tarefas agendadas
+ * 
+ * @param wheel Roda de temporização
+ * @param idle Prazo retornado quando não há tarefas agendadas
+ * @return uint32_t Instante (millis) em que timer_wheel_expire deve ser chamada novamente
+ */
+uint32_t timer_wheel_next(const timer_wheel_t *wheel, uint32_t idle){
+    uint32_t now = millis();
+    uint32_t next = idle;
+
+    for (uint8_t task = 0; task < TIMER_WHEEL_MAX_TASKS; task++)
+    {
+        if(!(wheel->scheduled & (1 << task))) continue;
+        if((int32_t)(wheel->deadlines[task] - now) <= 0) return now;
+        if((int32_t)(wheel->deadlines[task] - next) < 0) next = wheel->deadlines[task];
+    }
+    return next;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file timer_wheel.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Roda de temporização (timer wheel) para agendar várias tarefas em um único loop
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Cada tarefa possui um prazo (millis). O prazo cai em uma das
+ * TIMER_WHEEL_SLOTS posições da roda, de TIMER_WHEEL_TICK ms cada. A cada
+ * chamada de timer_wheel_expire() apenas as posições percorridas desde a
+ * última chamada são verificadas. Prazos além de uma volta da roda
+ * continuam na posição e são verificados a cada volta.
+ * 
+ */
+
+#ifndef __TIMERWHEEL__H__
+#define __TIMERWHEEL__H__
+
+#include "hal.h"
+
+#define TIMER_WHEEL_SLOTS 16            //!< Quantidade de posições da roda (potência de 2)
+#define TIMER_WHEEL_TICK_SHIFT 4        //!< Cada posição cobre 2^TIMER_WHEEL_TICK_SHIFT ms (16 ms, uma volta = 256 ms)
+#define TIMER_WHEEL_MAX_TASKS 8         //!< Quantidade máxima de tarefas (uma máscara de 8 bits por posição)
+
+/**
+ * @brief Estrutura de dados da roda de temporização
+ * 
+ */
+typedef struct
+{
+    uint32_t deadlines[TIMER_WHEEL_MAX_TASKS];  //!< Prazo de cada tarefa
+    uint8_t slots[TIMER_WHEEL_SLOTS];           //!< Tarefas agendadas em cada posição (bit n = tarefa n)
+    uint8_t scheduled;                          //!< Tarefas agendadas
+    uint32_t tick;                              //!< Última posição verificada (millis >> TIMER_WHEEL_TICK_SHIFT)
+}timer_wheel_t;
+
+void timer_wheel_init(timer_wheel_t *wheel);
+void timer_wheel_schedule(timer_wheel_t *wheel, uint8_t task, uint32_t deadline);
+void timer_wheel_cancel(timer_wheel_t *wheel, uint8_t task);
+uint8_t timer_wheel_expire(timer_wheel_t *wheel);
+uint32_t timer_wheel_next(const timer_wheel_t *wheel, uint32_t idle);
+
+#endif  //!__TIMERWHEEL__H__
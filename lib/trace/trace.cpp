@@ -0,0 +1,145 @@
+/**
+ * @file trace.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Gravador de eventos em memória, com registros binários de 8 bytes
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ */
+
+#include "trace.h"
+
+/**
+ * Variáveis globais
+ */
+HAL_THREAD_LOCAL trace_record_t trace_records[TRACE_SIZE];    //!< Buffer circular de registros
+HAL_THREAD_LOCAL uint8_t trace_head = 0;                      //!< Próxima posição a ser gravada
+HAL_THREAD_LOCAL uint8_t trace_used = 0;                      //!< Quantidade de registros válidos no buffer
+HAL_THREAD_LOCAL uint8_t trace_since_sync = TRACE_SIZE;       //!< Registros gravados desde o último TRACE_SYNC
+HAL_THREAD_LOCAL uint16_t trace_high = 0;                     //!< 16 bits mais significativos de millis() no último TRACE_SYNC
+HAL_THREAD_LOCAL uint8_t trace_mask = TRACE_MASK_ALL;         //!< Tipos gravados (bit n = tipo n)
+
+/**
+ * Protótipos das funções privadas
+ */
+void trace_store(uint16_t time, uint8_t type, uint8_t arg, uint32_t value);
+
+/**
+ * Funções Públicas
+ */
+
+/**
+ * @brief Esvazia o buffer de registros
+ * 
+ */
+void trace_init(){
+    trace_head = 0;
+    trace_used = 0;
+    trace_since_sync = TRACE_SIZE;
+}
+
+/**
+ * @brief Define os tipos de registro gravados
+ * 
+ * @param mask Bit n habilita o tipo n (TRACE_MASK_ALL grava todos). TRACE_SYNC é sempre gravado
+ */
+void trace_set_mask(uint8_t mask){
+    trace_mask = mask;
+}
+
+/**
+ * @brief Obtém os tipos de registro gravados
+ * 
+ * @return uint8_t Máscara definida por trace_set_mask()
+ */
+uint8_t trace_get_mask(){
+    return trace_mask;
+}
+
+/**
+ * @brief Grava um registro. Deve ser chamada apenas do loop principal
+ * 
+ * @param type Tipo do registro (trace_type_t), com a origem nos 4 bits mais significativos (ver TRACE_SOURCE)
+ * @param arg Argumento de 8 bits
+ * @param value Valor de 32 bits
+ */
+void trace_record(uint8_t type, uint8_t arg, uint32_t value){
+    if(!(trace_mask & (1 << (type & TRACE_TYPE_MASK)))) return;
+
+    uint32_t now = millis();
+    uint16_t high = now >> 16;
+
+    if(high != trace_high || trace_since_sync >= TRACE_SIZE / 4){
+        trace_high = high;
+        trace_since_sync = 0;
+        trace_store(now, TRACE_SYNC, 0, now);
+    }
+    trace_since_sync++;
+    trace_store(now, type, arg, value);
+}
+
+/**
+ * @brief Obtém a quantidade de registros no buffer
+ * 
+ * @return uint8_t Quantidade de registros (até TRACE_SIZE)
+ */
+uint8_t trace_count(){
+    return trace_used;
+}
+
+/**
+ * @brief Obtém um registro do buffer
+ * 
+ * @param index Índice do registro, do mais antigo (0) para o mais recente
+ * @param record Destino do registro
+ * @return true Se o registro existe
+ */
+bool trace_get(uint8_t index, trace_record_t *record){
+    if(index >= trace_used) return false;
+
+    *record = trace_records[(trace_head - trace_used + index) & (TRACE_SIZE - 1)];
+    return true;
+}
+
+/**
+ * @brief Converte um registro para o formato de transmissão, em little-endian
+ * 
+ * @param record Registro
+ * @param buffer Destino (TRACE_RECORD_SIZE bytes)
+ */
+void trace_pack(const trace_record_t *record, uint8_t *buffer){
+    buffer[0] = record->time;
+    buffer[1] = record->time >> 8;
+    buffer[2] = record->type;
+    buffer[3] = record->arg;
+    buffer[4] = record->value;
+    buffer[5] = record->value >> 8;
+    buffer[6] = record->value >> 16;
+    buffer[7] = record->value >> 24;
+}
+
+/**
+ * Funções privadas
+ */
+
+/**
+ * @brief Grava um registro na próxima posição do buffer
+ * 
+ * @param time 16 bits menos significativos de millis()
+ * @param type Tipo do registro
+ * @param arg Argumento
+ * @param value Valor
+ */
+void trace_store(uint16_t time, uint8_t type, uint8_t arg, uint32_t value){
+    trace_record_t *record = &trace_records[trace_head];
+
+    record->time = time;
+    record->type = type;
+    record->arg = arg;
+    record->value = value;
+
+    trace_head = (trace_head + 1) & (TRACE_SIZE - 1);
+    if(trace_used < TRACE_SIZE) trace_used++;
+}
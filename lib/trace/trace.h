@@ -0,0 +1,74 @@
+/**
+ * @file trace.h
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Gravador de eventos em memória, com registros binários de 8 bytes
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Os registros ficam em um buffer circular na RAM: quando cheio, o registro
+ * mais antigo é substituído. Gravar custa uma leitura de millis() e algumas
+ * escritas na memória, então o gravador pode ficar ligado em produção. O
+ * conteúdo é enviado pela telemetria com o comando dump (ver SerialCommand),
+ * extraído da captura com telemetry_decode -t e decodificado no computador
+ * pela ferramenta tools/trace_decode.
+ * 
+ * Cada registro guarda apenas os 16 bits menos significativos de millis().
+ * Um registro TRACE_SYNC com o valor completo é gravado sempre que os bits
+ * mais significativos mudam e a cada TRACE_SIZE / 4 registros, para que
+ * sempre exista um no buffer.
+ * 
+ */
+
+#ifndef __TRACE__H__
+#define __TRACE__H__
+
+#include "hal.h"
+
+#ifndef TRACE_SIZE
+#define TRACE_SIZE 32                   //!< Quantidade de registros do buffer (potência de 2, até 128)
+#endif
+
+#define TRACE_RECORD_SIZE 8             //!< Tamanho de um registro na transmissão, em bytes
+#define TRACE_MAGIC "TRC1"              //!< Início do arquivo de registros lido por trace_decode
+
+/**
+ * @brief Tipos de registro
+ */
+typedef enum
+{
+    TRACE_SYNC,                         //!< value = millis() completo
+    TRACE_STATE,                        //!< arg = novo estado da roleta, value = estado anterior
+    TRACE_FRAME,                        //!< arg = palavra do quadro, value = leds 32 * arg a 32 * arg + 31 (um registro por palavra, FRAME_WORDS)
+    TRACE_BUTTON,                       //!< arg = botão (bit 7 = descartado como trepidação), value = instante do pressionamento
+    TRACE_DRAW_START,                   //!< arg = led sorteado, value = duração prevista do giro em ms
+    TRACE_DRAW_RESULT,                  //!< arg = led sorteado, value = quantidade de sorteios anteriores
+    TRACE_TYPES                         //!< Quantidade de tipos
+}trace_type_t;
+
+#define TRACE_TYPE_MASK 0x0F            //!< Bits do tipo no campo type. Os 4 bits mais significativos indicam a origem (ex.: a roleta)
+#define TRACE_SOURCE(type, source) ((uint8_t)((type) | ((source) << 4)))   //!< Tipo de registro com a origem
+#define TRACE_MASK_ALL 0xFF             //!< Máscara que grava todos os tipos
+#define TRACE_BUTTON_BOUNCE 0x80        //!< Bit de arg em TRACE_BUTTON indicando pressionamento descartado
+
+/**
+ * @brief Registro de evento
+ */
+typedef struct
+{
+    uint16_t time;                      //!< 16 bits menos significativos de millis()
+    uint8_t type;                       //!< Tipo do registro (trace_type_t) e origem (4 bits mais significativos)
+    uint8_t arg;                        //!< Argumento de 8 bits
+    uint32_t value;                     //!< Valor de 32 bits
+}trace_record_t;
+
+void trace_init();
+void trace_set_mask(uint8_t mask);
+uint8_t trace_get_mask();
+void trace_record(uint8_t type, uint8_t arg, uint32_t value);
+uint8_t trace_count();
+bool trace_get(uint8_t index, trace_record_t *record);
+void trace_pack(const trace_record_t *record, uint8_t *buffer);
+
+#endif  //!__TRACE__H__
@@ -9,10 +9,13 @@
  * 
  */
 
-#include <Arduino.h>
+#include "hal.h"
 #include "ElectronicRoulette.h"
+#include "telemetry.h"
+#include "SerialCommand.h"
 
 ElectronicRoulette roleta;        //!< Instância global da roleta
+SerialCommand comandos(&roleta);  //!< Comandos recebidos pela serial para configurar e acionar a roleta
 
 uint8_t numerosDaSorte[24] = {3, 2, 4, 2, 3, 4, 1, 5, 6, 3, 7, 2, 1, 5, 2, 5, 3, 6, 5, 4, 1, 8, 3, 1};    //!< Lista de números a serem sorteados
 
@@ -44,7 +47,49 @@ void setup() {
  * 
  */
 void loop() {
-  // put your main code here, to run repeatedly:
-  roleta.task();
-  roleta.printLedsStatus();
-}
\ No newline at end of file
+  uint32_t deadline = roleta.task();            //Atualiza a roleta e obtém o instante da próxima atualização.
+  comandos.task();                              //Executa os comandos recebidos pela serial (ex.: "set speed 90;get duration")
+  telemetry_flush();                            //Envia a telemetria e as respostas, sem bloquear enquanto a serial estiver ocupada
+  hal_sleep_until(telemetry_deadline(deadline));   //Dorme até a próxima atualização, ou até um botão ser pressionado. Acorda antes se há telemetria aguardando a serial.
+}
+
+#ifndef ARDUINO
+
+#define NATIVE_RUN_TIME 60000                   //!< Tempo virtual padrão de execução no ambiente native, em milissegundos
+#define NATIVE_LOOP_TIME 50                     //!< Custo estimado de uma iteração do loop, em microssegundos de relógio virtual
+#define NATIVE_READY_TIME 5000                  //!< Instante em que o botão que prepara a roleta é pressionado na simulação
+#define NATIVE_START_TIME 6000                  //!< Instante em que o botão que inicia o sorteio é pressionado na simulação
+#define NATIVE_RESTART_TIME 30000               //!< Instante em que a roleta volta aos efeitos na simulação
+
+/**
+ * @brief Ponto de entrada do ambiente native. Executa setup() e loop() sobre o relógio virtual
+ *
+ * @param argc Quantidade de argumentos
+ * @param argv argv[1] opcional com o tempo virtual de execução, em milissegundos
+ * @return int Código de saída
+ */
+int main(int argc, char **argv){
+  unsigned long runTime = argc > 1 ? strtoul(argv[1], NULL, 10) : NATIVE_RUN_TIME;
+
+  hal_reset();
+  setup();
+
+  hal_schedule_interrupt(digitalPinToInterrupt(DEFAULT_BT_RDY_PIN), NATIVE_READY_TIME);
+  hal_schedule_interrupt(digitalPinToInterrupt(DEFAULT_BT_START_PIN), NATIVE_START_TIME);
+  hal_schedule_interrupt(digitalPinToInterrupt(DEFAULT_BT_RDY_PIN), NATIVE_RESTART_TIME);
+
+  while (millis() < runTime)
+  {
+    hal_clock_advance(NATIVE_LOOP_TIME);
+    loop();
+  }
+  Serial.flush();
+
+  uint64_t total = hal_clock_us();
+  uint64_t awake = total - hal_sleep_us();
+  fprintf(stderr, "tempo virtual: %llu ms, acordado: %llu ms, ciclo de trabalho: %.2f%%\n",
+    (unsigned long long)(total / 1000), (unsigned long long)(awake / 1000), total ? 100.0 * awake / total : 0.0);
+  return 0;
+}
+
+#endif
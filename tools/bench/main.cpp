@@ -0,0 +1,456 @@
+/**
+ * @file main.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Mede o custo por chamada dos trechos mais executados da roleta no computador e imprime o resultado em JSON
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * Uso: bench [-L rótulo] [-r repetições] [-n chamadas] [-f filtro]
+ *
+ * Cada medida executa o trecho ao menos -n vezes (padrão 200000), -r
+ * vezes (padrão 5), e guarda a repetição mais rápida, que é a menos
+ * afetada pelas outras tarefas do computador. São medidos:
+ *
+ *  - effect/<n>: um passo de bits_effects_all() em cada posição da lista
+ *    de reprodução (0 a EFFECTS_COUNT - 1). O contexto é restaurado no
+ *    início do efeito e o temporizador é parado antes de cada chamada,
+ *    então todos os passos do efeito são executados, sem esperar o prazo;
+ *  - drawing/<saída>: um passo do sorteio (ElectronicRoulette::task() em
+ *    ST_DRAWING, com drawing() e updateLeds()) para cada saída dos leds,
+ *    incluindo o avanço do relógio virtual até o prazo do passo;
+ *  - led_write/<saída>: LedOutput::write() com quadros alternados, isto é,
+ *    o trabalho de updateLeds() em cada saída;
+ *  - draw_source/<fonte> e fast_random/below: o número de cada sorteio, que
+ *    substituiu a antiga randomizeNumbersList().
+ *
+ * O JSON é impresso na saída padrão e pode ser salvo para comparar versões
+ * (o rótulo -L identifica a versão). -f executa apenas as medidas cujo
+ * nome contém o filtro. Os tempos são do computador, não do ATmega328P.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "ElectronicRoulette.h"
+#include "GpioLedOutput.h"
+#include "ShiftRegisterLedOutput.h"
+#include "SimLedOutput.h"
+#include "StaticGpioLedOutput.h"
+#include "TimerLedOutput.h"
+#include "RandomDrawSource.h"
+#include "RingDrawSource.h"
+#include "ProgmemDrawSource.h"
+#include "EepromDrawSource.h"
+#include "fast_random.h"
+#include "bits_effects.h"
+#include "trace.h"
+
+#define DEFAULT_REPETITIONS 5           //!< Repetições de cada medida (-r)
+#define DEFAULT_CALLS 200000            //!< Chamadas mínimas por repetição (-n)
+#define BENCH_LEDS DEFAULT_LED_COUNT    //!< Leds da roleta e das saídas medidas
+#define BENCH_INITIAL_PIN 4             //!< Primeiro pino das saídas por GPIO
+#define BENCH_LATCH_PIN 10              //!< Pino de latch do registrador de deslocamento
+#define BENCH_EFFECT_SPEED 64           //!< Velocidade dos efeitos, a mesma da roleta com a velocidade padrão
+#define BENCH_SEED 1                    //!< Semente fixa, para que todas as versões meçam os mesmos sorteios
+#define BENCH_SEQUENCE_SIZE 24          //!< Números das fontes predeterminadas
+
+/**
+ * @brief Saídas dos leds medidas
+ */
+typedef enum
+{
+    BENCH_OUTPUT_GPIO,                  //!< GpioLedOutput
+    BENCH_OUTPUT_SHIFT,                 //!< ShiftRegisterLedOutput
+    BENCH_OUTPUT_SIM,                   //!< SimLedOutput
+    BENCH_OUTPUT_TIMER,                 //!< TimerLedOutput sobre uma GpioLedOutput
+    BENCH_OUTPUT_STATIC_GPIO,           //!< StaticGpioLedOutput
+    BENCH_OUTPUT_COUNT
+}bench_output_t;
+
+const char *outputNames[BENCH_OUTPUT_COUNT] = {"gpio", "shift", "sim", "timer", "static_gpio"};
+
+/**
+ * @brief Fontes de sorteio medidas
+ */
+typedef enum
+{
+    BENCH_SOURCE_RANDOM,                //!< RandomDrawSource
+    BENCH_SOURCE_RING,                  //!< RingDrawSource repetindo a lista
+    BENCH_SOURCE_PROGMEM,               //!< ProgmemDrawSource compactada
+    BENCH_SOURCE_EEPROM,                //!< EepromDrawSource compactada
+    BENCH_SOURCE_COUNT
+}bench_source_t;
+
+const char *sourceNames[BENCH_SOURCE_COUNT] = {"random", "ring", "progmem", "eeprom"};
+
+const uint8_t benchSequence[BENCH_SEQUENCE_SIZE / 2] PROGMEM = {
+    DRAW_SOURCE_PACK(3, 5), DRAW_SOURCE_PACK(1, 7), DRAW_SOURCE_PACK(0, 2),
+    DRAW_SOURCE_PACK(6, 4), DRAW_SOURCE_PACK(5, 5), DRAW_SOURCE_PACK(2, 1),
+    DRAW_SOURCE_PACK(7, 0), DRAW_SOURCE_PACK(4, 3), DRAW_SOURCE_PACK(6, 1),
+    DRAW_SOURCE_PACK(3, 2), DRAW_SOURCE_PACK(0, 7), DRAW_SOURCE_PACK(5, 4),
+};
+
+/**
+ * @brief Uma medida
+ */
+typedef struct bench_case
+{
+    char name[32];                      //!< Nome no JSON
+    uint64_t (*run)(const struct bench_case *bench, uint64_t calls);    //!< Executa ao menos calls chamadas e devolve quantas foram executadas
+    uint8_t param;                      //!< Parâmetro da medida (efeito, saída ou fonte)
+}bench_case_t;
+
+/**
+ * @brief Resultado de uma medida
+ */
+typedef struct
+{
+    uint64_t calls;                     //!< Chamadas da repetição mais rápida
+    double nsPerCall;                   //!< Tempo por chamada da repetição mais rápida, em nanossegundos
+}bench_result_t;
+
+/**
+ * @brief Valor lido pelas medidas, para que o compilador não descarte as chamadas
+ */
+volatile uint32_t sink;
+
+/**
+ * @brief Cria uma saída dos leds
+ *
+ * @param output Saída desejada
+ * @param gpio Saída por GPIO usada como destino da TimerLedOutput
+ * @return LedOutput* Saída alocada (liberar com delete)
+ */
+LedOutput *createOutput(uint8_t output, GpioLedOutput *gpio){
+    switch (output)
+    {
+    case BENCH_OUTPUT_GPIO:
+        return new GpioLedOutput(BENCH_INITIAL_PIN);
+    case BENCH_OUTPUT_SHIFT:
+        return new ShiftRegisterLedOutput(BENCH_LATCH_PIN);
+    case BENCH_OUTPUT_SIM:
+        return new SimLedOutput();
+    case BENCH_OUTPUT_TIMER:
+        return new TimerLedOutput(gpio);
+    default:
+        return new StaticGpioLedOutput<BENCH_INITIAL_PIN, BENCH_LEDS>();
+    }
+}
+
+/**
+ * @brief Mede os passos de um efeito da lista de reprodução
+ *
+ * @param bench Medida (param = posição na lista)
+ * @param calls Chamadas mínimas
+ * @return uint64_t Chamadas executadas
+ */
+uint64_t benchEffect(const bench_case_t *bench, uint64_t calls){
+    bits_effects_t effects;
+    bits_effects_t start;
+    uint64_t done = 0;
+
+    hal_reset();
+    bits_effects_init(&effects, BENCH_LEDS, BENCH_EFFECT_SPEED);
+
+    // Avança até a chamada que inicia o efeito pedido
+    start = effects;
+    while (bench->param != 0)
+    {
+        start = effects;
+        soft_timer_stop(&effects.timer);
+        bits_effects_all(&effects);
+        if(effects.selected_effect == bench->param && start.selected_effect != bench->param) break;
+    }
+
+    while (done < calls)
+    {
+        effects = start;
+        do
+        {
+            soft_timer_stop(&effects.timer);
+            sink += bits_effects_all(&effects);
+            done++;
+        } while (!effects.effect_done);
+    }
+    sink += effects.bits.words[0];
+    return done;
+}
+
+/**
+ * @brief Mede os passos do sorteio com uma saída dos leds
+ *
+ * @param bench Medida (param = saída)
+ * @param calls Chamadas mínimas
+ * @return uint64_t Chamadas executadas
+ */
+uint64_t benchDrawing(const bench_case_t *bench, uint64_t calls){
+    ElectronicRoulette roleta;
+    GpioLedOutput gpio(BENCH_INITIAL_PIN);
+    LedOutput *output;
+    uint64_t done = 0;
+
+    hal_reset();
+    trace_set_mask(0);
+    output = createOutput(bench->param, &gpio);
+    roleta.setLedCount(BENCH_LEDS);
+    roleta.setLedOutput(output);
+    roleta.setSeed(BENCH_SEED);
+    roleta.begin();
+
+    while (done < calls)
+    {
+        // Os botões são pressionados fora do trecho medido, respeitando o debounce
+        hal_clock_advance(BUTTON_DEBOUNCE_TIME * 1000UL);
+        roleta.pressReady();
+        roleta.task();
+        hal_clock_advance(BUTTON_DEBOUNCE_TIME * 1000UL);
+        roleta.pressStart();
+        uint32_t deadline = roleta.task();
+
+        while (roleta.getState() == ElectronicRouletteState::ST_DRAWING)
+        {
+            uint32_t now = millis();
+            if((int32_t)(deadline - now) > 0) hal_clock_advance((deadline - now) * 1000UL);
+            deadline = roleta.task();
+            done++;
+        }
+    }
+    if(bench->param == BENCH_OUTPUT_TIMER) ((TimerLedOutput *)output)->end();
+    delete output;
+    return done;
+}
+
+/**
+ * @brief Mede a escrita de quadros em uma saída dos leds
+ *
+ * @param bench Medida (param = saída)
+ * @param calls Chamadas mínimas
+ * @return uint64_t Chamadas executadas
+ */
+uint64_t benchLedWrite(const bench_case_t *bench, uint64_t calls){
+    GpioLedOutput gpio(BENCH_INITIAL_PIN);
+    LedOutput *output;
+    bits_frame_t frames[BENCH_LEDS];
+
+    hal_reset();
+    output = createOutput(bench->param, &gpio);
+    if(bench->param == BENCH_OUTPUT_TIMER) gpio.begin(BENCH_LEDS);
+    output->begin(BENCH_LEDS);
+
+    // Um led aceso por vez, como no sorteio: cada escrita muda dois leds
+    for (uint8_t i = 0; i < BENCH_LEDS; i++)
+    {
+        bits_frame_clear(&frames[i]);
+        bits_frame_set(&frames[i], i);
+    }
+
+    for (uint64_t i = 0; i < calls; i++)
+    {
+        sink += output->write(&frames[i % BENCH_LEDS]);
+    }
+    if(bench->param == BENCH_OUTPUT_TIMER) ((TimerLedOutput *)output)->end();
+    delete output;
+    return calls;
+}
+
+/**
+ * @brief Mede o próximo número de uma fonte de sorteios
+ *
+ * @param bench Medida (param = fonte)
+ * @param calls Chamadas mínimas
+ * @return uint64_t Chamadas executadas
+ */
+uint64_t benchDrawSource(const bench_case_t *bench, uint64_t calls){
+    uint8_t buffer[BENCH_SEQUENCE_SIZE];
+    RandomDrawSource random;
+    RingDrawSource ring(buffer, sizeof(buffer));
+    ProgmemDrawSource progmem(benchSequence, BENCH_SEQUENCE_SIZE, true);
+    EepromDrawSource eeprom(0, BENCH_SEQUENCE_SIZE, true);
+    DrawSource *source;
+
+    hal_reset();
+    for (uint8_t i = 0; i < sizeof(benchSequence); i++)
+    {
+        EEPROM.write(i, pgm_read_byte(&benchSequence[i]));
+    }
+
+    switch (bench->param)
+    {
+    case BENCH_SOURCE_RANDOM:
+        random.setSeed(BENCH_SEED);
+        source = &random;
+        break;
+    case BENCH_SOURCE_RING:
+        ring.setRepeat(true);
+        source = &ring;
+        break;
+    case BENCH_SOURCE_PROGMEM:
+        source = &progmem;
+        break;
+    default:
+        source = &eeprom;
+        break;
+    }
+    source->begin(BENCH_LEDS);
+    if(bench->param == BENCH_SOURCE_RING){
+        for (uint8_t i = 0; i < BENCH_SEQUENCE_SIZE; i++)
+        {
+            ring.push(i % BENCH_LEDS);
+        }
+    }
+
+    for (uint64_t i = 0; i < calls; i++)
+    {
+        sink += source->next();
+    }
+    return calls;
+}
+
+/**
+ * @brief Mede fast_random_below() com a quantidade de leds da roleta
+ *
+ * @param bench Medida
+ * @param calls Chamadas mínimas
+ * @return uint64_t Chamadas executadas
+ */
+uint64_t benchFastRandom(const bench_case_t *bench, uint64_t calls){
+    fast_random_t random;
+
+    (void)bench;
+    fast_random_seed(&random, BENCH_SEED);
+    for (uint64_t i = 0; i < calls; i++)
+    {
+        sink += fast_random_below(&random, BENCH_LEDS);
+    }
+    return calls;
+}
+
+/**
+ * @brief Executa as repetições de uma medida
+ *
+ * @param bench Medida
+ * @param calls Chamadas mínimas por repetição
+ * @param repetitions Quantidade de repetições
+ * @return bench_result_t Repetição mais rápida
+ */
+bench_result_t measure(const bench_case_t *bench, uint64_t calls, unsigned repetitions){
+    bench_result_t result = {0, 0};
+
+    bench->run(bench, calls / 10 + 1);      // Aquece caches e o preditor de desvios
+    for (unsigned i = 0; i < repetitions; i++)
+    {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        uint64_t done = bench->run(bench, calls);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - begin).count() / done;
+
+        if(i == 0 || ns < result.nsPerCall){
+            result.calls = done;
+            result.nsPerCall = ns;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Adiciona uma medida à lista
+ *
+ * @param cases Lista de medidas
+ * @param run Função da medida
+ * @param param Parâmetro da medida
+ * @param format Formato do nome (printf)
+ * @param value Valor do nome
+ */
+void addCase(std::vector<bench_case_t> &cases, uint64_t (*run)(const bench_case_t *, uint64_t), uint8_t param, const char *format, const char *value){
+    bench_case_t bench;
+
+    snprintf(bench.name, sizeof(bench.name), format, value);
+    bench.run = run;
+    bench.param = param;
+    cases.push_back(bench);
+}
+
+/**
+ * @brief Imprime um texto como string JSON
+ *
+ * @param text Texto
+ */
+void printJsonString(const char *text){
+    putchar('"');
+    for (; *text; text++)
+    {
+        if(*text == '"' || *text == '\\') putchar('\\');
+        if((uint8_t)*text < 0x20) printf("\\u%04x", *text);
+        else putchar(*text);
+    }
+    putchar('"');
+}
+
+int main(int argc, char *argv[]){
+    const char *label = "";
+    const char *filter = NULL;
+    unsigned repetitions = DEFAULT_REPETITIONS;
+    uint64_t calls = DEFAULT_CALLS;
+    std::vector<bench_case_t> cases;
+    char number[4];
+
+    for (int i = 1; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "-L") && i + 1 < argc) label = argv[++i];
+        else if(!strcmp(argv[i], "-r") && i + 1 < argc) repetitions = strtoul(argv[++i], NULL, 0);
+        else if(!strcmp(argv[i], "-n") && i + 1 < argc) calls = strtoull(argv[++i], NULL, 0);
+        else if(!strcmp(argv[i], "-f") && i + 1 < argc) filter = argv[++i];
+        else{
+            fprintf(stderr, "uso: %s [-L rótulo] [-r repetições] [-n chamadas] [-f filtro]\n", argv[0]);
+            return 1;
+        }
+    }
+    if(repetitions == 0 || calls == 0){
+        fprintf(stderr, "-r e -n precisam ser maiores que zero\n");
+        return 1;
+    }
+
+    for (uint8_t i = 0; i < EFFECTS_COUNT; i++)
+    {
+        snprintf(number, sizeof(number), "%u", i);
+        addCase(cases, benchEffect, i, "effect/%s", number);
+    }
+    for (uint8_t i = 0; i < BENCH_OUTPUT_COUNT; i++)
+    {
+        addCase(cases, benchDrawing, i, "drawing/%s", outputNames[i]);
+    }
+    for (uint8_t i = 0; i < BENCH_OUTPUT_COUNT; i++)
+    {
+        addCase(cases, benchLedWrite, i, "led_write/%s", outputNames[i]);
+    }
+    for (uint8_t i = 0; i < BENCH_SOURCE_COUNT; i++)
+    {
+        addCase(cases, benchDrawSource, i, "draw_source/%s", sourceNames[i]);
+    }
+    addCase(cases, benchFastRandom, 0, "fast_random/%s", "below");
+
+    printf("{\n  \"label\": ");
+    printJsonString(label);
+    printf(",\n  \"repetitions\": %u,\n  \"benchmarks\": [", repetitions);
+
+    bool first = true;
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        if(filter != NULL && strstr(cases[i].name, filter) == NULL) continue;
+
+        bench_result_t result = measure(&cases[i], calls, repetitions);
+        printf("%s\n    {\"name\": ", first ? "" : ",");
+        printJsonString(cases[i].name);
+        printf(", \"calls\": %llu, \"ns_per_call\": %.3f, \"calls_per_s\": %.0f}",
+            (unsigned long long)result.calls, result.nsPerCall, 1e9 / result.nsPerCall);
+        fflush(stdout);
+        first = false;
+    }
+    printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,331 @@
+/**
+ * @file main.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Verifica por Monte Carlo se todos os leds da roleta são sorteados com a mesma probabilidade
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Uso: fairness [-n sorteios] [-l leds] [-t threads] [-s semente] [-P]
+ * 
+ * Cada thread simula uma roleta completa (ElectronicRoulette sobre o shim
+ * da lib/hal, compilado com HAL_THREADS), pressionando os botões como um
+ * operador: prepara, inicia, espera o led sorteado e volta aos efeitos. O
+ * relógio virtual salta direto para o prazo devolvido por task(), então
+ * apenas os passos que a placa executaria são simulados.
+ * 
+ * O resultado de cada sorteio é o led aceso quando a roleta para, lido da
+ * saída simulada. São impressos a frequência de cada led, o teste
+ * qui-quadrado da uniformidade, a distribuição das sequências de resultados
+ * iguais comparada com a esperada, e os sorteios em que a roleta parou fora
+ * do led pedido à fonte de sorteios (deve ser sempre 0). -P desabilita o
+ * planejamento do giro (setStopPlanner(false)).
+ * 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <thread>
+#include <vector>
+#include "ElectronicRoulette.h"
+#include "SimLedOutput.h"
+
+#define DEFAULT_DRAWS 1000000ULL        //!< Quantidade padrão de sorteios
+#define MAX_RUN 16                      //!< Sequências de resultados iguais a partir deste tamanho são somadas juntas
+#define MIN_EXPECTED 5.0                //!< Menor contagem esperada de uma classe no qui-quadrado
+
+/**
+ * @brief Fonte de números aleatórios que guarda o último led pedido pela roleta
+ */
+class RecordingDrawSource : public RandomDrawSource
+{
+public:
+    uint8_t last;                                   //!< Último led entregue à roleta
+
+    uint8_t next(){
+        this->last = RandomDrawSource::next();
+        return this->last;
+    }
+};
+
+/**
+ * @brief Resultado de uma thread
+ */
+typedef struct
+{
+    uint64_t draws;                     //!< Sorteios a simular
+    uint32_t seed;                      //!< Semente da fonte de sorteios
+    uint8_t ledsCount;                  //!< Quantidade de leds da roleta
+    bool planner;                       //!< Planejamento do giro habilitado
+    uint64_t counts[FRAME_MAX_BITS];    //!< Quantidade de sorteios de cada led
+    uint64_t runs[MAX_RUN + 1];         //!< Quantidade de sequências de cada tamanho (1 a MAX_RUN, a última inclui as maiores)
+    uint32_t longestRun;                //!< Maior sequência de resultados iguais
+    uint64_t mismatches;                //!< Sorteios que pararam fora do led pedido
+    uint64_t steps;                     //!< Chamadas de task()
+    uint64_t virtualMs;                 //!< Tempo virtual simulado
+}worker_t;
+
+/**
+ * @brief Simula os sorteios de uma thread
+ * 
+ * @param worker Configuração e resultado da thread
+ */
+void simulate(worker_t *worker){
+    ElectronicRoulette roleta;
+    SimLedOutput output;
+    RecordingDrawSource source;
+    uint8_t previous = 0xFF;
+    uint32_t run = 0;
+    uint32_t lastPress = 0;
+    bool recorded = false;
+    ElectronicRouletteState state;
+
+    hal_reset();
+    trace_set_mask(0);
+    source.setSeed(worker->seed);
+    roleta.setLedCount(worker->ledsCount);
+    roleta.setLedOutput(&output);
+    roleta.setDrawSource(&source);
+    roleta.setStopPlanner(worker->planner);
+    roleta.begin();
+
+    for (uint64_t draw = 0; draw < worker->draws;)
+    {
+        uint32_t deadline = roleta.task();
+        uint32_t now = millis();
+
+        worker->steps++;
+        state = roleta.getState();
+
+        if(state != ElectronicRouletteState::ST_DRAWN){
+            recorded = false;
+        }else if(!recorded){
+            const bits_frame_t *frame = output.getFrame();
+            uint8_t led = 0;
+
+            while (led < worker->ledsCount && !bits_frame_get(frame, led)) led++;
+            worker->counts[led < worker->ledsCount ? led : 0]++;
+            if(led != source.last) worker->mismatches++;
+
+            if(led == previous){
+                run++;
+            }else{
+                if(run > 0) worker->runs[run < MAX_RUN ? run : MAX_RUN]++;
+                if(run > worker->longestRun) worker->longestRun = run;
+                run = 1;
+                previous = led;
+            }
+            recorded = true;
+            draw++;
+        }
+
+        // Um pressionamento por vez, respeitando o intervalo do debounce
+        if((uint32_t)(now - lastPress) >= BUTTON_DEBOUNCE_TIME && state != ElectronicRouletteState::ST_DRAWING){
+            if(state == ElectronicRouletteState::ST_READY) roleta.pressStart();
+            else roleta.pressReady();
+            lastPress = now;
+            continue;
+        }
+
+        if((int32_t)(deadline - now) < 1) deadline = now + 1;
+        if((int32_t)(deadline - (lastPress + BUTTON_DEBOUNCE_TIME)) > 0 && state != ElectronicRouletteState::ST_DRAWING){
+            deadline = lastPress + BUTTON_DEBOUNCE_TIME;
+        }
+        hal_clock_advance((deadline - now) * 1000UL);
+    }
+
+    if(run > 0) worker->runs[run < MAX_RUN ? run : MAX_RUN]++;
+    if(run > worker->longestRun) worker->longestRun = run;
+    worker->virtualMs = millis();
+}
+
+/**
+ * @brief Calcula a função gama incompleta regularizada superior Q(a, x)
+ * @note Série para x < a + 1 e fração contínua (Lentz) nos demais casos
+ * 
+ * @param a Parâmetro de forma
+ * @param x Limite inferior da integral
+ * @return double Q(a, x)
+ */
+double gammaQ(double a, double x){
+    if(x <= 0) return 1.0;
+
+    double lnFactor = a * log(x) - x - lgamma(a);
+
+    if(x < a + 1){
+        double term = 1.0 / a;
+        double sum = term;
+
+        for (int n = 1; n < 1000 && fabs(term) > fabs(sum) * 1e-15; n++)
+        {
+            term *= x / (a + n);
+            sum += term;
+        }
+        return 1.0 - sum * exp(lnFactor);
+    }
+
+    double b = x + 1 - a;
+    double c = 1e300;
+    double d = 1.0 / b;
+    double h = d;
+
+    for (int n = 1; n < 1000; n++)
+    {
+        double an = -n * (n - a);
+        b += 2;
+        d = an * d + b;
+        if(fabs(d) < 1e-300) d = 1e-300;
+        c = b + an / c;
+        if(fabs(c) < 1e-300) c = 1e-300;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if(fabs(delta - 1.0) < 1e-15) break;
+    }
+    return exp(lnFactor) * h;
+}
+
+/**
+ * @brief Obtém o valor-p do teste qui-quadrado
+ * 
+ * @param chi2 Estatística qui-quadrado
+ * @param df Graus de liberdade
+ * @return double Probabilidade de uma estatística maior ou igual com a hipótese verdadeira
+ */
+double chiSquarePValue(double chi2, unsigned df){
+    return gammaQ(df / 2.0, chi2 / 2.0);
+}
+
+/**
+ * @brief Mostra como utilizar a ferramenta
+ * 
+ */
+void usage(){
+    fprintf(stderr, "uso: fairness [-n sorteios] [-l leds] [-t threads] [-s semente] [-P]\n");
+}
+
+int main(int argc, char **argv){
+    uint64_t draws = DEFAULT_DRAWS;
+    unsigned ledsCount = DEFAULT_LED_COUNT;
+    unsigned threads = std::thread::hardware_concurrency();
+    uint32_t seed = 1;
+    bool planner = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "-P") == 0){
+            planner = false;
+        }else if(i + 1 < argc && strcmp(argv[i], "-n") == 0){
+            draws = strtoull(argv[++i], NULL, 10);
+        }else if(i + 1 < argc && strcmp(argv[i], "-l") == 0){
+            ledsCount = strtoul(argv[++i], NULL, 10);
+        }else if(i + 1 < argc && strcmp(argv[i], "-t") == 0){
+            threads = strtoul(argv[++i], NULL, 10);
+        }else if(i + 1 < argc && strcmp(argv[i], "-s") == 0){
+            seed = strtoul(argv[++i], NULL, 10);
+        }else{
+            usage();
+            return 1;
+        }
+    }
+    if(ledsCount < 2 || ledsCount > FRAME_MAX_BITS || draws == 0){
+        fprintf(stderr, "a roleta precisa de 2 a %u leds, e ao menos um sorteio\n", FRAME_MAX_BITS);
+        return 1;
+    }
+    if(threads == 0) threads = 1;
+    if(threads > draws) threads = draws;
+
+    std::vector<worker_t> workers(threads);
+    std::vector<std::thread> pool;
+
+    for (unsigned t = 0; t < threads; t++)
+    {
+        worker_t *worker = &workers[t];
+
+        memset(worker, 0, sizeof(worker_t));
+        worker->draws = draws / threads + (t < draws % threads ? 1 : 0);
+        worker->seed = seed + t * 0x9E3779B9UL;
+        worker->ledsCount = ledsCount;
+        worker->planner = planner;
+        pool.push_back(std::thread(simulate, worker));
+    }
+    for (unsigned t = 0; t < threads; t++)
+    {
+        pool[t].join();
+    }
+
+    uint64_t counts[FRAME_MAX_BITS] = {0};
+    uint64_t runs[MAX_RUN + 1] = {0};
+    uint64_t totalRuns = 0;
+    uint32_t longestRun = 0;
+    uint64_t mismatches = 0;
+    uint64_t steps = 0;
+    double virtualHours = 0;
+
+    for (unsigned t = 0; t < threads; t++)
+    {
+        for (unsigned i = 0; i < ledsCount; i++) counts[i] += workers[t].counts[i];
+        for (unsigned k = 1; k <= MAX_RUN; k++) runs[k] += workers[t].runs[k];
+        if(workers[t].longestRun > longestRun) longestRun = workers[t].longestRun;
+        mismatches += workers[t].mismatches;
+        steps += workers[t].steps;
+        virtualHours += workers[t].virtualMs / 3600000.0;
+    }
+
+    double expected = (double)draws / ledsCount;
+    double chi2 = 0;
+
+    printf("%llu sorteios, %u leds, %u threads, semente %lu, planejamento %s\n",
+        (unsigned long long)draws, ledsCount, threads, (unsigned long)seed, planner ? "ligado" : "desligado");
+    printf("%.1f horas de tempo virtual, %llu chamadas de task()\n\n", virtualHours, (unsigned long long)steps);
+    printf("led   sorteios      frequência  desvio (sigmas)\n");
+    for (unsigned i = 0; i < ledsCount; i++)
+    {
+        double diff = counts[i] - expected;
+        double sigma = sqrt(expected * (1.0 - 1.0 / ledsCount));
+
+        chi2 += diff * diff / expected;
+        printf("%3u  %12llu   %.6f   %+7.2f\n", i + 1, (unsigned long long)counts[i], (double)counts[i] / draws, diff / sigma);
+    }
+    printf("\nuniformidade: qui-quadrado %.2f, %u graus de liberdade, valor-p %.4f\n", chi2, ledsCount - 1, chiSquarePValue(chi2, ledsCount - 1));
+
+    // Sequências de resultados iguais: com sorteios independentes, o tamanho segue uma distribuição geométrica
+    double repeat = 1.0 / ledsCount;
+    double runChi2 = 0;
+    double pending = 0;
+    double pendingExpected = 0;
+    unsigned runClasses = 0;
+
+    for (unsigned k = 1; k <= MAX_RUN; k++) totalRuns += runs[k];
+    printf("\nsequências de resultados iguais: %llu, a maior com %lu sorteios\n", (unsigned long long)totalRuns, (unsigned long)longestRun);
+    printf("tamanho   observadas      esperadas\n");
+    for (unsigned k = 1; k <= MAX_RUN; k++)
+    {
+        double probability = k < MAX_RUN ? (1.0 - repeat) * pow(repeat, k - 1) : pow(repeat, k - 1);
+        double expectedRuns = totalRuns * probability;
+
+        if(runs[k] > 0 || expectedRuns >= 0.5){
+            printf("%5u%s  %12llu  %13.1f\n", k, k < MAX_RUN ? " " : "+", (unsigned long long)runs[k], expectedRuns);
+        }
+        // Classes com contagem esperada pequena são somadas à seguinte
+        pending += runs[k];
+        pendingExpected += expectedRuns;
+        if(pendingExpected >= MIN_EXPECTED || k == MAX_RUN){
+            if(pendingExpected > 0){
+                runChi2 += (pending - pendingExpected) * (pending - pendingExpected) / pendingExpected;
+                runClasses++;
+            }
+            pending = 0;
+            pendingExpected = 0;
+        }
+    }
+    if(runClasses > 1){
+        printf("sequências: qui-quadrado %.2f, %u graus de liberdade, valor-p %.4f\n", runChi2, runClasses - 1, chiSquarePValue(runChi2, runClasses - 1));
+    }
+
+    printf("\nsorteios fora do led pedido: %llu\n", (unsigned long long)mismatches);
+    return mismatches ? 2 : 0;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file main.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Simula um salão inteiro de roletas por horas de tempo virtual, para o planejamento de capacidade
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * Uso: floor_sim [-w roletas] [-H horas] [-p pausa_ms] [-l leds] [-v velocidade]
+ *                [-d desaceleração] [-D parada] [-T giro_ms] [-e curva] [-P] [-s semente] [-V verificadas]
+ *
+ * Todas as roletas têm a mesma configuração e avançam juntas no lote da
+ * lib/spin_batch. Cada roleta recebe uma lista aleatória de 24 números e
+ * começa em um instante aleatório dentro da primeira pausa; depois de cada
+ * parada, espera a pausa e gira de novo. São impressos os sorteios por
+ * roleta e por hora, a duração média do giro, a fração do tempo girando e
+ * a velocidade da simulação.
+ *
+ * As primeiras roletas (-V, padrão 4) também são simuladas uma a uma pela
+ * ElectronicRoulette sobre o shim da lib/hal, com um operador que prepara a
+ * roleta após cada parada e a inicia no mesmo instante do lote. O led e o
+ * instante de cada parada precisam ser iguais nos dois; as diferenças são
+ * contadas e a ferramenta termina com código 2.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include "ElectronicRoulette.h"
+#include "SimLedOutput.h"
+#include "spin_batch.h"
+#include "fast_random.h"
+
+#define DEFAULT_WHEELS 1000             //!< Quantidade padrão de roletas
+#define DEFAULT_HOURS 1                 //!< Tempo virtual padrão, em horas
+#define DEFAULT_PAUSE 30000             //!< Pausa padrão entre a parada e o próximo giro, em milissegundos
+#define DEFAULT_VERIFY 4                //!< Roletas conferidas com a ElectronicRoulette
+#define MAX_HOURS 1000                  //!< Tempo virtual máximo (millis() volta a zero em ~1193 horas)
+
+/**
+ * @brief Parada de uma roleta
+ */
+typedef struct
+{
+    uint32_t time;                      //!< Instante (millis) da parada
+    uint8_t led;                        //!< Led sorteado
+}stop_t;
+
+/**
+ * @brief Simula uma roleta com a ElectronicRoulette, com a mesma configuração e os mesmos instantes de início do lote
+ *
+ * @param config Configuração do lote
+ * @param speed Velocidade da roleta (0 a 100)
+ * @param numbers Lista de números da roleta (1 a ledsCount)
+ * @param first Instante do primeiro giro
+ * @param end Instante final da simulação
+ * @param stops Paradas da roleta
+ * @return true Se o operador conseguiu iniciar todos os giros no instante do lote
+ */
+bool simulateWheel(const spin_batch_config_t *config, uint8_t speed, uint8_t numbers[SPIN_BATCH_LIST_SIZE], uint32_t first, uint32_t end, std::vector<stop_t> *stops){
+    ElectronicRoulette roleta;
+    SimLedOutput output;
+    uint32_t startAt = first;
+    uint32_t nextReady = 0;
+    bool recorded = false;
+
+    hal_reset();
+    trace_set_mask(0);
+    roleta.setLedCount(config->ledsCount);
+    roleta.setSpeed(speed);
+    roleta.setDeceleration(config->deceleration);
+    roleta.setDuration(config->stopDeceleration);
+    roleta.setStopPlanner(config->stopPlanner);
+    roleta.setSpinTime(config->spinTime);
+    roleta.setEasing(config->easing);
+    roleta.setNumbersList(numbers);
+    roleta.setLedOutput(&output);
+    roleta.begin();
+
+    while ((int32_t)(millis() - end) <= 0)
+    {
+        uint32_t deadline = roleta.task();
+        uint32_t now = millis();
+        ElectronicRouletteState state = roleta.getState();
+
+        if(state != ElectronicRouletteState::ST_DRAWN){
+            recorded = false;
+        }else if(!recorded){
+            const bits_frame_t *frame = output.getFrame();
+            stop_t stop = {now, 0};
+
+            while (stop.led < config->ledsCount && !bits_frame_get(frame, stop.led)) stop.led++;
+            stops->push_back(stop);
+            recorded = true;
+            nextReady = now + BUTTON_DEBOUNCE_TIME;
+            startAt = now + config->pause;
+        }
+
+        if(state == ElectronicRouletteState::ST_READY && (int32_t)(now - startAt) >= 0){
+            roleta.pressStart();
+            continue;
+        }
+        if(state == ElectronicRouletteState::ST_IDLE || state == ElectronicRouletteState::ST_DRAWN){
+            if((int32_t)(now - startAt) >= 0) return false;
+            if((int32_t)(now - nextReady) >= 0){
+                roleta.pressReady();
+                nextReady = now + BUTTON_DEBOUNCE_TIME;
+                continue;
+            }
+            if((int32_t)(deadline - nextReady) > 0) deadline = nextReady;
+        }
+        if(state != ElectronicRouletteState::ST_DRAWING && (int32_t)(deadline - startAt) > 0) deadline = startAt;
+        if((int32_t)(deadline - now) < 1) deadline = now + 1;
+        hal_clock_advance((deadline - now) * 1000UL);
+    }
+    return true;
+}
+
+/**
+ * @brief Mostra como utilizar a ferramenta
+ *
+ */
+void usage(){
+    fprintf(stderr, "uso: floor_sim [-w roletas] [-H horas] [-p pausa_ms] [-l leds] [-v velocidade] [-d desaceleração]\n");
+    fprintf(stderr, "                [-D parada] [-T giro_ms] [-e curva] [-P] [-s semente] [-V verificadas]\n");
+}
+
+int main(int argc, char **argv){
+    spin_batch_config_t config;
+    uint32_t wheels = DEFAULT_WHEELS;
+    double hours = DEFAULT_HOURS;
+    unsigned speed = DEFAULT_INITIAL_SPEED;
+    unsigned verify = DEFAULT_VERIFY;
+    uint32_t seed = 1;
+    unsigned long value;
+
+    config.ledsCount = DEFAULT_LED_COUNT;
+    config.deceleration = DEFAULT_DECELERATION;
+    config.stopDeceleration = DEFAULT_STOP;
+    config.stopPlanner = true;
+    config.spinTime = 0;
+    config.easing = SPIN_EASING_LINEAR;
+    config.pause = DEFAULT_PAUSE;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "-P") == 0){
+            config.stopPlanner = false;
+            continue;
+        }
+        if(i + 1 >= argc || argv[i][0] != '-' || strlen(argv[i]) != 2){
+            usage();
+            return 1;
+        }
+        if(argv[i][1] == 'H'){
+            hours = atof(argv[++i]);
+            continue;
+        }
+
+        value = strtoul(argv[++i], NULL, 10);
+        switch (argv[i - 1][1])
+        {
+        case 'w': wheels = value; break;
+        case 'p': config.pause = value; break;
+        case 'l': config.ledsCount = value; break;
+        case 'v': speed = value; break;
+        case 'd': config.deceleration = value; break;
+        case 'D': config.stopDeceleration = value; break;
+        case 'T':
+            if(value > SPIN_PROFILE_MAX_SPIN_TIME){
+                fprintf(stderr, "a duração do giro vai até %u ms\n", SPIN_PROFILE_MAX_SPIN_TIME);
+                return 1;
+            }
+            config.spinTime = value;
+            break;
+        case 'e': config.easing = (spin_easing_t)value; break;
+        case 's': seed = value; break;
+        case 'V': verify = value; break;
+        default:
+            usage();
+            return 1;
+        }
+    }
+    if(config.ledsCount < 2 || config.ledsCount > FRAME_MAX_BITS || speed > 100 || config.easing >= SPIN_EASING_COUNT){
+        fprintf(stderr, "a roleta precisa de 2 a %u leds, velocidade de 0 a 100 e curva de 0 a %u\n", FRAME_MAX_BITS, SPIN_EASING_COUNT - 1);
+        return 1;
+    }
+    if(wheels == 0 || hours <= 0 || hours > MAX_HOURS || config.pause == 0){
+        fprintf(stderr, "são necessárias ao menos uma roleta, até %u horas e uma pausa maior que 0\n", MAX_HOURS);
+        return 1;
+    }
+    if(verify > wheels) verify = wheels;
+    config.time = roulette_speed_to_time(speed);
+
+    spin_batch_t batch;
+    fast_random_t random;
+    std::vector<uint8_t> lists((size_t)wheels * SPIN_BATCH_LIST_SIZE);
+    std::vector<uint32_t> firsts(wheels);
+    uint32_t end = hours * 3600000.0;
+
+    if(!spin_batch_init(&batch, wheels, &config)){
+        fprintf(stderr, "configuração com giros que nunca terminam, ou memória insuficiente\n");
+        return 1;
+    }
+
+    fast_random_seed(&random, seed);
+    for (uint32_t wheel = 0; wheel < wheels; wheel++)
+    {
+        uint8_t *numbers = &lists[(size_t)wheel * SPIN_BATCH_LIST_SIZE];
+
+        for (uint32_t k = 0; k < SPIN_BATCH_LIST_SIZE; k++)
+        {
+            numbers[k] = fast_random_below(&random, config.ledsCount) + 1;
+        }
+        firsts[wheel] = fast_random_next(&random) % config.pause;
+        spin_batch_set_numbers(&batch, wheel, numbers);
+        spin_batch_begin(&batch, wheel, firsts[wheel]);
+    }
+
+    // A cada janela de meia pausa, cada roleta para no máximo uma vez: as paradas das roletas verificadas são conferidas
+    std::vector<std::vector<stop_t> > expected(verify);
+    std::vector<bool> feasible(verify);
+    uint64_t mismatches = 0;
+    uint32_t window = config.pause / 2 ? config.pause / 2 : 1;
+    clock_t clockStart;
+    double wallTime = 0;
+
+    for (unsigned wheel = 0; wheel < verify; wheel++)
+    {
+        feasible[wheel] = simulateWheel(&config, speed, &lists[(size_t)wheel * SPIN_BATCH_LIST_SIZE], firsts[wheel], end, &expected[wheel]);
+        if(!feasible[wheel]) fprintf(stderr, "roleta %u: a pausa é curta para o operador preparar a ElectronicRoulette, verificação incompleta\n", wheel);
+    }
+
+    for (uint32_t now = 0; (int32_t)(now - end) < 0;)
+    {
+        now = (int32_t)(end - now) > (int32_t)window ? now + window : end;
+
+        clockStart = clock();
+        spin_batch_run(&batch, now);
+        wallTime += (double)(clock() - clockStart) / CLOCKS_PER_SEC;
+
+        for (unsigned wheel = 0; wheel < verify; wheel++)
+        {
+            uint32_t draws = batch.draws[wheel];
+
+            if(draws == 0 || draws > expected[wheel].size()) continue;
+            if(expected[wheel][draws - 1].time != (uint32_t)batch.lastStop[wheel] || expected[wheel][draws - 1].led != batch.result[wheel]){
+                mismatches++;
+            }
+        }
+    }
+
+    uint64_t draws = 0;
+    uint64_t steps = 0;
+    uint64_t spinning = 0;
+    uint64_t checked = 0;
+
+    for (uint32_t wheel = 0; wheel < wheels; wheel++)
+    {
+        draws += (uint32_t)batch.draws[wheel];
+        steps += (uint32_t)batch.steps[wheel];
+        spinning += (uint32_t)batch.spinning[wheel];
+    }
+    for (unsigned wheel = 0; wheel < verify; wheel++)
+    {
+        // Paradas que só uma das simulações fez no último instante também são diferenças
+        if(feasible[wheel] && expected[wheel].size() != (uint32_t)batch.draws[wheel]) mismatches++;
+        checked += batch.draws[wheel];
+    }
+
+    printf("%lu roletas, %.2f horas, %u leds, velocidade %u, desaceleração %u, parada %u, pausa %lu ms, planejamento %s\n",
+        (unsigned long)wheels, hours, config.ledsCount, speed, config.deceleration, config.stopDeceleration,
+        (unsigned long)config.pause, config.stopPlanner ? "ligado" : "desligado");
+    printf("%llu sorteios, %.2f por roleta por hora, giro médio de %.0f ms, %.1f%% do tempo girando\n",
+        (unsigned long long)draws, draws / (double)wheels / hours, draws ? (double)spinning / draws : 0.0,
+        100.0 * spinning / ((double)wheels * end));
+    printf("%llu passos em %.3f s (%.1f milhões de passos/s, %s)\n", (unsigned long long)steps, wallTime,
+        wallTime > 0 ? steps / wallTime / 1e6 : 0.0, spin_batch_has_avx2() ? "AVX2, 8 roletas por vez" : "uma roleta por vez");
+    printf("verificação: %llu sorteios de %u roletas conferidos com a ElectronicRoulette, %llu diferenças\n",
+        (unsigned long long)checked, verify, (unsigned long long)mismatches);
+
+    spin_batch_free(&batch);
+    return mismatches ? 2 : 0;
+}
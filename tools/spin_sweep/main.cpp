@@ -0,0 +1,307 @@
+/**
+ * @file main.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Percorre a grade de velocidade, desaceleração e parada e mostra como cada combinação gira
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * Uso: spin_sweep [-v início:fim:passo] [-d início:fim:passo] [-D início:fim:passo]
+ *                 [-l leds] [-T giro_ms] [-e curva] [-P] [-c cadência_ms] [-n linhas] [-t threads] [-C]
+ *
+ * -v, -d e -D são os valores de setSpeed(), setDeceleration() e
+ * setDuration(). Para cada combinação, o giro é calculado para todos os
+ * pares (led inicial, led sorteado), que são igualmente prováveis quando o
+ * sorteio não tem viés, com as mesmas tabelas de passos da lib/spin_batch
+ * (idênticas a ElectronicRoulette::drawing()). São impressos a
+ * distribuição da duração do giro (mínimo, percentis 10, 50 e 90, máximo e
+ * média), a quantidade de passos e o excesso na velocidade de parada: o
+ * tempo entre o primeiro passo com duração de parada e a parada (negativo
+ * quando o planejamento para antes dele).
+ *
+ * Com -c, as combinações são ordenadas pela distância entre a duração
+ * média do giro e a cadência desejada, e apenas as -n primeiras são
+ * impressas. As combinações são distribuídas entre as threads (-t, padrão
+ * uma por núcleo). -C imprime em CSV.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "ElectronicRoulette.h"
+#include "spin_batch.h"
+
+#define DEFAULT_ROWS 20                 //!< Linhas impressas com -c
+
+/**
+ * @brief Faixa de valores de um parâmetro
+ */
+typedef struct
+{
+    unsigned first;                     //!< Primeiro valor
+    unsigned last;                      //!< Último valor
+    unsigned step;                      //!< Incremento
+}sweep_range_t;
+
+/**
+ * @brief Resultado de uma combinação
+ */
+typedef struct
+{
+    uint8_t speed;                      //!< Velocidade (setSpeed)
+    uint8_t deceleration;               //!< Desaceleração (setDeceleration)
+    uint8_t stop;                       //!< Parada (setDuration)
+    bool endless;                       //!< Algum giro nunca termina
+    uint32_t duration[5];               //!< Duração do giro: mínimo, percentis 10, 50 e 90 e máximo, em milissegundos
+    double mean;                        //!< Duração média do giro
+    uint32_t minSteps;                  //!< Menor quantidade de passos
+    double meanSteps;                   //!< Quantidade média de passos
+    uint32_t maxSteps;                  //!< Maior quantidade de passos
+    double meanOvershoot;               //!< Excesso médio na velocidade de parada, em milissegundos
+    int32_t maxOvershoot;               //!< Maior excesso na velocidade de parada
+}sweep_result_t;
+
+/**
+ * @brief Lê uma faixa no formato início:fim:passo (ou um valor único)
+ *
+ * @param text Texto do argumento
+ * @param range Faixa lida
+ * @param max Maior valor aceito
+ * @return true Se a faixa é válida
+ */
+bool parseRange(const char *text, sweep_range_t *range, unsigned max){
+    char *end;
+
+    range->first = strtoul(text, &end, 10);
+    range->last = range->first;
+    range->step = 1;
+    if(*end == ':') range->last = strtoul(end + 1, &end, 10);
+    if(*end == ':') range->step = strtoul(end + 1, &end, 10);
+    return *end == '\0' && range->step > 0 && range->first <= range->last && range->last <= max;
+}
+
+/**
+ * @brief Calcula os giros de uma combinação
+ *
+ * @param config Configuração, com time, deceleration e stopDeceleration da combinação
+ * @param result Resultado
+ */
+void evaluate(const spin_batch_config_t *config, sweep_result_t *result){
+    spin_batch_t batch;
+    spin_profile_t base;
+    uint32_t pairs = (uint32_t)config->ledsCount * config->ledsCount;
+    std::vector<uint32_t> durations(pairs);
+    double steps = 0;
+    double overshoot = 0;
+
+    result->endless = !spin_batch_init(&batch, 1, config);
+    if(result->endless) return;
+
+    spin_profile_build(&base, config->time, config->deceleration, config->stopDeceleration, config->ledsCount, config->easing);
+    result->minSteps = 0xFFFFFFFF;
+    result->maxSteps = 0;
+    result->maxOvershoot = INT32_MIN;
+
+    for (uint32_t pair = 0; pair < pairs; pair++)
+    {
+        const int32_t *row = batch.times + batch.rows[pair];
+        int32_t stop = batch.plans[pair];
+        uint32_t duration = 0;
+        uint32_t settled = 0;
+
+        // A roleta para ao entrar no último passo: a duração dele não conta
+        for (int32_t step = 0; step < stop; step++)
+        {
+            if(step == base.settleStep) settled = duration;
+            duration += row[step];
+        }
+        if(base.settleStep == SPIN_PROFILE_ENDLESS){
+            settled = duration;
+        }else if(stop <= base.settleStep){
+            settled = duration;
+            for (int32_t step = stop; step < base.settleStep; step++) settled += spin_profile_step_time(&base, step);
+        }
+
+        int32_t excess = (int32_t)(duration - settled);
+
+        durations[pair] = duration;
+        steps += stop + 1;
+        overshoot += excess;
+        if((uint32_t)stop + 1 < result->minSteps) result->minSteps = stop + 1;
+        if((uint32_t)stop + 1 > result->maxSteps) result->maxSteps = stop + 1;
+        if(excess > result->maxOvershoot) result->maxOvershoot = excess;
+    }
+    spin_batch_free(&batch);
+
+    std::sort(durations.begin(), durations.end());
+    result->duration[0] = durations[0];
+    result->duration[1] = durations[(pairs - 1) / 10];
+    result->duration[2] = durations[(pairs - 1) / 2];
+    result->duration[3] = durations[(pairs - 1) * 9 / 10];
+    result->duration[4] = durations[pairs - 1];
+
+    result->mean = 0;
+    for (uint32_t pair = 0; pair < pairs; pair++) result->mean += durations[pair];
+    result->mean /= pairs;
+    result->meanSteps = steps / pairs;
+    result->meanOvershoot = overshoot / pairs;
+}
+
+/**
+ * @brief Mostra como utilizar a ferramenta
+ *
+ */
+void usage(){
+    fprintf(stderr, "uso: spin_sweep [-v início:fim:passo] [-d início:fim:passo] [-D início:fim:passo]\n");
+    fprintf(stderr, "                [-l leds] [-T giro_ms] [-e curva] [-P] [-c cadência_ms] [-n linhas] [-t threads] [-C]\n");
+}
+
+int main(int argc, char **argv){
+    sweep_range_t speeds = {0, 100, 10};
+    sweep_range_t decelerations = {1, 10, 1};
+    sweep_range_t stops = {50, 250, 25};
+    spin_batch_config_t config;
+    unsigned threads = std::thread::hardware_concurrency();
+    unsigned rows = DEFAULT_ROWS;
+    double cadence = 0;
+    bool csv = false;
+    bool valid = true;
+
+    config.ledsCount = DEFAULT_LED_COUNT;
+    config.stopPlanner = true;
+    config.spinTime = 0;
+    config.easing = SPIN_EASING_LINEAR;
+    config.pause = 1;
+
+    for (int i = 1; i < argc && valid; i++)
+    {
+        if(strcmp(argv[i], "-P") == 0){
+            config.stopPlanner = false;
+        }else if(strcmp(argv[i], "-C") == 0){
+            csv = true;
+        }else if(i + 1 >= argc){
+            valid = false;
+        }else if(strcmp(argv[i], "-v") == 0){
+            valid = parseRange(argv[++i], &speeds, 100);
+        }else if(strcmp(argv[i], "-d") == 0){
+            valid = parseRange(argv[++i], &decelerations, 0xFF);
+        }else if(strcmp(argv[i], "-D") == 0){
+            valid = parseRange(argv[++i], &stops, 0xFF);
+        }else if(strcmp(argv[i], "-l") == 0){
+            config.ledsCount = strtoul(argv[++i], NULL, 10);
+        }else if(strcmp(argv[i], "-T") == 0){
+            unsigned long spinTime = strtoul(argv[++i], NULL, 10);
+            valid = spinTime <= SPIN_PROFILE_MAX_SPIN_TIME;
+            config.spinTime = spinTime;
+        }else if(strcmp(argv[i], "-e") == 0){
+            config.easing = (spin_easing_t)strtoul(argv[++i], NULL, 10);
+        }else if(strcmp(argv[i], "-c") == 0){
+            cadence = atof(argv[++i]);
+        }else if(strcmp(argv[i], "-n") == 0){
+            rows = strtoul(argv[++i], NULL, 10);
+        }else if(strcmp(argv[i], "-t") == 0){
+            threads = strtoul(argv[++i], NULL, 10);
+        }else{
+            valid = false;
+        }
+    }
+    if(!valid){
+        usage();
+        return 1;
+    }
+    if(config.ledsCount < 2 || config.ledsCount > FRAME_MAX_BITS || config.easing >= SPIN_EASING_COUNT){
+        fprintf(stderr, "a roleta precisa de 2 a %u leds, e a curva vai de 0 a %u\n", FRAME_MAX_BITS, SPIN_EASING_COUNT - 1);
+        return 1;
+    }
+    if(threads == 0) threads = 1;
+
+    std::vector<sweep_result_t> results;
+
+    for (unsigned speed = speeds.first; speed <= speeds.last; speed += speeds.step)
+    {
+        for (unsigned deceleration = decelerations.first; deceleration <= decelerations.last; deceleration += decelerations.step)
+        {
+            for (unsigned stop = stops.first; stop <= stops.last; stop += stops.step)
+            {
+                sweep_result_t result;
+
+                memset(&result, 0, sizeof(result));
+                result.speed = speed;
+                result.deceleration = deceleration;
+                result.stop = stop;
+                results.push_back(result);
+            }
+        }
+    }
+
+    // Cada thread pega a próxima combinação ainda não calculada
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+
+    for (unsigned t = 0; t < threads; t++)
+    {
+        pool.push_back(std::thread([&](){
+            spin_batch_config_t local = config;
+            size_t index;
+
+            while ((index = next++) < results.size())
+            {
+                sweep_result_t *result = &results[index];
+
+                local.time = roulette_speed_to_time(result->speed);
+                local.deceleration = result->deceleration;
+                local.stopDeceleration = result->stop;
+                evaluate(&local, result);
+            }
+        }));
+    }
+    for (unsigned t = 0; t < threads; t++)
+    {
+        pool[t].join();
+    }
+
+    if(cadence > 0){
+        std::stable_sort(results.begin(), results.end(), [cadence](const sweep_result_t &a, const sweep_result_t &b){
+            if(a.endless != b.endless) return b.endless;
+            return fabs(a.mean - cadence) < fabs(b.mean - cadence);
+        });
+        if(results.size() > rows) results.resize(rows);
+    }
+
+    if(csv){
+        printf("speed,deceleration,stop,min_ms,p10_ms,p50_ms,p90_ms,max_ms,mean_ms,min_steps,mean_steps,max_steps,mean_overshoot_ms,max_overshoot_ms\n");
+    }else{
+        printf("%u leds, planejamento %s, curva %u, %u combinações\n\n", config.ledsCount, config.stopPlanner ? "ligado" : "desligado",
+            config.easing, (unsigned)results.size());
+        printf("vel desac parada |  duração do giro (ms): mín    p10    p50    p90    máx    média |  passos: mín  média  máx | excesso (ms): média  máx\n");
+    }
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const sweep_result_t *r = &results[i];
+
+        if(r->endless){
+            if(csv) printf("%u,%u,%u,,,,,,,,,,,\n", r->speed, r->deceleration, r->stop);
+            else printf("%3u %5u %6u |  não para\n", r->speed, r->deceleration, r->stop);
+            continue;
+        }
+        if(csv){
+            printf("%u,%u,%u,%lu,%lu,%lu,%lu,%lu,%.1f,%lu,%.2f,%lu,%.1f,%ld\n", r->speed, r->deceleration, r->stop,
+                (unsigned long)r->duration[0], (unsigned long)r->duration[1], (unsigned long)r->duration[2], (unsigned long)r->duration[3],
+                (unsigned long)r->duration[4], r->mean, (unsigned long)r->minSteps, r->meanSteps, (unsigned long)r->maxSteps,
+                r->meanOvershoot, (long)r->maxOvershoot);
+        }else{
+            printf("%3u %5u %6u | %28lu %6lu %6lu %6lu %6lu %8.0f | %11lu %6.1f %4lu | %19.0f %4ld\n", r->speed, r->deceleration, r->stop,
+                (unsigned long)r->duration[0], (unsigned long)r->duration[1], (unsigned long)r->duration[2], (unsigned long)r->duration[3],
+                (unsigned long)r->duration[4], r->mean, (unsigned long)r->minSteps, r->meanSteps, (unsigned long)r->maxSteps,
+                r->meanOvershoot, (long)r->maxOvershoot);
+        }
+    }
+    return 0;
+}
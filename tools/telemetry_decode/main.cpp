@@ -0,0 +1,318 @@
+/**
+ * @file main.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Decodifica a telemetria binária das roletas (lib/telemetry) em uma linha por mudança
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Uso: telemetry_decode [arquivo] [-t registros.bin]
+ * 
+ * Com -t, os registros do trace enviados pelo comando dump são gravados
+ * após TRACE_MAGIC e a quantidade de registros, para serem lidos pela
+ * ferramenta trace_decode.
+ * 
+ * Lê a captura da serial (do arquivo ou da entrada padrão). Até o primeiro
+ * TELEMETRY_SYNC, e sempre que encontra uma mensagem inválida (ex.: texto
+ * de depuração no meio da telemetria), o decodificador procura
+ * o próximo TELEMETRY_MAGIC. Ao final, as estatísticas da captura são
+ * impressas na saída de erros.
+ * 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "telemetry.h"
+#include "trace.h"
+
+#define CHANNELS 16                     //!< Quantidade de canais (4 bits do cabeçalho)
+#define FRAME_BYTES 32                  //!< Bytes do maior quadro aceito (256 leds)
+
+/**
+ * @brief Estado de um canal, reconstruído a partir das mensagens
+ */
+typedef struct
+{
+    bool synced;                        //!< Indica se um TELEMETRY_SYNC do canal já foi lido
+    uint8_t ledsCount;                  //!< Quantidade de leds da roleta
+    uint8_t state;                      //!< Estado da roleta
+    uint8_t frame[FRAME_BYTES];         //!< Quadro dos leds
+}channel_t;
+
+/**
+ * @brief Nomes dos estados da roleta (ElectronicRouletteState)
+ */
+const char *stateNames[] = {"IDLE", "READY", "DRAWING", "DRAWN"};
+
+channel_t channels[CHANNELS];           //!< Estado de cada canal
+FILE *input;                            //!< Arquivo de entrada
+FILE *traceOutput;                      //!< Destino dos registros do trace (NULL = não grava)
+uint32_t now;                           //!< Instante (millis) da última mensagem
+unsigned long bytesRead;                //!< Bytes lidos da captura
+unsigned long skipped;                  //!< Bytes descartados procurando TELEMETRY_MAGIC
+unsigned long frames;                   //!< Mensagens TELEMETRY_FRAME decodificadas
+unsigned long frameBytes;               //!< Bytes das mensagens TELEMETRY_FRAME
+unsigned long dropped;                  //!< Mudanças descartadas informadas pela roleta
+unsigned long traceRecords;             //!< Registros do trace recebidos
+
+/**
+ * @brief Lê um byte da captura
+ * 
+ * @param value Destino do byte
+ * @return true Se o byte foi lido
+ */
+bool readByte(uint8_t *value){
+    int c = fgetc(input);
+
+    if(c == EOF) return false;
+    bytesRead++;
+    *value = c;
+    return true;
+}
+
+/**
+ * @brief Lê um varint
+ * 
+ * @param value Destino do valor
+ * @return true Se o varint foi lido e cabe em 32 bits
+ */
+bool readVarint(uint32_t *value){
+    uint8_t c;
+
+    *value = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7)
+    {
+        if(!readByte(&c)) return false;
+        *value |= (uint32_t)(c & 0x7F) << shift;
+        if(!(c & 0x80)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Obtém a quantidade de bytes do quadro de um canal
+ * 
+ * @param channel Canal
+ * @return uint8_t Bytes do quadro
+ */
+uint8_t channelBytes(const channel_t *channel){
+    return (channel->ledsCount + 7) / 8;
+}
+
+/**
+ * @brief Imprime o início de uma linha
+ * 
+ * @param source Número do canal
+ */
+void printPrefix(uint8_t source){
+    printf("%10lu ms  roleta %u  ", (unsigned long)now, source);
+}
+
+/**
+ * @brief Imprime o quadro de um canal, do led 0 ao último (mesma ordem de printLedsStatus)
+ * 
+ * @param channel Canal
+ */
+void printFrame(const channel_t *channel){
+    for (uint16_t i = 0; i < channel->ledsCount; i++)
+    {
+        putchar((channel->frame[i / 8] >> (i % 8)) & 1 ? '1' : '0');
+    }
+    putchar('\n');
+}
+
+/**
+ * @brief Decodifica um TELEMETRY_SYNC, após o TELEMETRY_MAGIC
+ * 
+ * @return true Se a mensagem é válida
+ */
+bool decodeSync(){
+    uint8_t header, ledsCount, state;
+    uint32_t time;
+
+    if(!readByte(&header) || (header >> 4) != TELEMETRY_SYNC) return false;
+    if(!readVarint(&time) || !readByte(&ledsCount) || !readByte(&state)) return false;
+    if(ledsCount == 0 || ledsCount > FRAME_BYTES * 8) return false;
+
+    channel_t *channel = &channels[header & 0x0F];
+    uint8_t frame[FRAME_BYTES];
+    uint8_t bytes = (ledsCount + 7) / 8;
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        if(!readByte(&frame[i])) return false;
+    }
+
+    // O sincronismo também leva as mudanças que ainda não tinham sido enviadas
+    bool changed = !channel->synced || channel->ledsCount != ledsCount || memcmp(channel->frame, frame, bytes) != 0;
+    now = time;
+    if(!channel->synced || channel->ledsCount != ledsCount || channel->state != state){
+        printPrefix(header & 0x0F);
+        printf("sincronismo, %u leds, %s\n", ledsCount, state < 4 ? stateNames[state] : "?");
+    }
+    channel->synced = true;
+    channel->ledsCount = ledsCount;
+    channel->state = state;
+    memcpy(channel->frame, frame, bytes);
+    if(changed){
+        printPrefix(header & 0x0F);
+        printFrame(channel);
+    }
+    return true;
+}
+
+/**
+ * @brief Decodifica uma mensagem que não pertence a uma roleta (resposta ou registro do trace)
+ * 
+ * @param header Cabeçalho da mensagem
+ * @return true Se a mensagem é válida
+ */
+bool decodeHost(uint8_t header){
+    uint8_t data[256];
+    uint32_t delta;
+    uint8_t size;
+
+    if((header & 0x0F) != TELEMETRY_SOURCE_HOST || !readVarint(&delta) || !readByte(&size)) return false;
+    for (uint16_t i = 0; i < size; i++)
+    {
+        if(!readByte(&data[i])) return false;
+    }
+    now += delta;
+
+    if((header >> 4) == TELEMETRY_REPLY){
+        printf("%10lu ms  resposta  %.*s\n", (unsigned long)now, size, (const char *)data);
+
+        // A resposta do comando dump informa quantos registros do trace vêm a seguir
+        if(traceOutput && size > 5 && memcmp(data, "dump=", 5) == 0){
+            data[size] = '\0';
+            fwrite(TRACE_MAGIC, 1, 4, traceOutput);
+            fputc(atoi((const char *)&data[5]), traceOutput);
+        }
+        return true;
+    }
+
+    if(size != TRACE_RECORD_SIZE) return false;
+    traceRecords++;
+    if(traceOutput) fwrite(data, 1, TRACE_RECORD_SIZE, traceOutput);
+    return true;
+}
+
+/**
+ * @brief Decodifica uma mensagem a partir do cabeçalho
+ * 
+ * @param header Cabeçalho da mensagem
+ * @return true Se a mensagem é válida
+ */
+bool decodeMessage(uint8_t header){
+    channel_t *channel = &channels[header & 0x0F];
+    uint8_t type = header >> 4;
+    unsigned long start = bytesRead - 1;
+    uint32_t delta, value;
+    uint8_t c;
+
+    if(type == TELEMETRY_REPLY || type == TELEMETRY_TRACE) return decodeHost(header);
+    if(!channel->synced || type < TELEMETRY_FRAME || type > TELEMETRY_DROPPED) return false;
+    if(!readVarint(&delta)) return false;
+    now += delta;
+
+    switch (type)
+    {
+    case TELEMETRY_FRAME:
+    {
+        uint8_t mask[FRAME_BYTES / 8];
+        uint8_t bytes = channelBytes(channel);
+
+        for (uint8_t i = 0; i < (bytes + 7) / 8; i++)
+        {
+            if(!readByte(&mask[i])) return false;
+        }
+        for (uint8_t i = 0; i < bytes; i++)
+        {
+            if(!(mask[i / 8] & (1 << (i % 8)))) continue;
+            if(!readByte(&c)) return false;
+            channel->frame[i] ^= c;
+        }
+        frames++;
+        frameBytes += bytesRead - start;
+        printPrefix(header & 0x0F);
+        printFrame(channel);
+        break;
+    }
+    case TELEMETRY_STATE:
+        if(!readByte(&c)) return false;
+        printPrefix(header & 0x0F);
+        printf("estado     %s -> %s\n", channel->state < 4 ? stateNames[channel->state] : "?", c < 4 ? stateNames[c] : "?");
+        channel->state = c;
+        break;
+    case TELEMETRY_DROPPED:
+        if(!readVarint(&value)) return false;
+        dropped += value;
+        printPrefix(header & 0x0F);
+        printf("%lu mudanças descartadas pela roleta (serial ocupada)\n", (unsigned long)value);
+        break;
+    }
+    return true;
+}
+
+int main(int argc, char **argv){
+    const char *magic = TELEMETRY_MAGIC;
+    uint8_t matched = 0;
+    bool scanning = true;
+    uint8_t c;
+
+    const char *inputName = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "-t") == 0 && i + 1 < argc){
+            traceOutput = fopen(argv[++i], "wb");
+            if(traceOutput == NULL){
+                perror(argv[i]);
+                return 1;
+            }
+        }else{
+            inputName = argv[i];
+        }
+    }
+
+    input = inputName ? fopen(inputName, "rb") : stdin;
+    if(input == NULL){
+        perror(inputName);
+        return 1;
+    }
+
+    while (readByte(&c))
+    {
+        // TELEMETRY_MAGIC nunca é um cabeçalho válido: indica dados de outra origem (ex.: texto de depuração) ou um novo sincronismo
+        if(!scanning && c == (uint8_t)magic[0]){
+            matched = 1;
+            scanning = true;
+            continue;
+        }
+        if(scanning){
+            if(c == (uint8_t)magic[matched]){
+                if(++matched < TELEMETRY_MAGIC_SIZE) continue;
+                matched = 0;
+                scanning = !decodeSync();
+            }else{
+                skipped += matched + 1;
+                matched = c == (uint8_t)magic[0] ? 1 : 0;
+                if(matched) skipped--;
+            }
+            continue;
+        }
+        if(!decodeMessage(c)){
+            printf("--- mensagem inválida, procurando o próximo sincronismo\n");
+            scanning = true;
+            matched = 0;
+        }
+    }
+
+    fprintf(stderr, "%lu bytes, %lu quadros (%.1f bytes por quadro), %lu mudanças descartadas, %lu registros do trace, %lu bytes ignorados\n",
+        bytesRead, frames, frames ? (double)frameBytes / frames : 0.0, dropped, traceRecords, skipped);
+    if(input != stdin) fclose(input);
+    if(traceOutput) fclose(traceOutput);
+    return 0;
+}
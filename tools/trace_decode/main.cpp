@@ -0,0 +1,160 @@
+/**
+ * @file main.cpp
+ * @author Wesley José Santos (binary-quantum.com)
+ * @brief Decodifica o registro de eventos extraído por telemetry_decode -t em uma linha do tempo
+ * @version 1.0
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Uso: trace_decode [arquivo]
+ * 
+ * Lê os registros (do arquivo ou da entrada padrão), procura o início de
+ * cada transmissão (TRACE_MAGIC), ignorando o que houver em volta, e
+ * imprime um evento por linha.
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "trace.h"
+
+/**
+ * @brief Nomes dos estados da roleta (ElectronicRouletteState)
+ */
+const char *stateNames[] = {"IDLE", "READY", "DRAWING", "DRAWN"};
+
+/**
+ * @brief Obtém o nome de um estado
+ * 
+ * @param state Estado da roleta
+ * @return const char* Nome do estado
+ */
+const char *stateName(uint32_t state){
+    return state < sizeof(stateNames) / sizeof(stateNames[0]) ? stateNames[state] : "?";
+}
+
+/**
+ * @brief Lê um registro de 8 bytes em little-endian
+ * 
+ * @param input Arquivo de entrada
+ * @param record Destino do registro
+ * @return true Se o registro foi lido por completo
+ */
+bool readRecord(FILE *input, trace_record_t *record){
+    uint8_t buffer[TRACE_RECORD_SIZE];
+
+    if(fread(buffer, 1, TRACE_RECORD_SIZE, input) != TRACE_RECORD_SIZE) return false;
+
+    record->time = buffer[0] | (buffer[1] << 8);
+    record->type = buffer[2];
+    record->arg = buffer[3];
+    record->value = buffer[4] | ((uint32_t)buffer[5] << 8) | ((uint32_t)buffer[6] << 16) | ((uint32_t)buffer[7] << 24);
+    return true;
+}
+
+/**
+ * @brief Imprime um registro na linha do tempo
+ * 
+ * @param record Registro
+ * @param high 16 bits mais significativos de millis(), do último TRACE_SYNC
+ * @param synced Indica se algum TRACE_SYNC já foi lido
+ */
+void printRecord(const trace_record_t *record, uint16_t high, bool synced){
+    uint8_t type = record->type & TRACE_TYPE_MASK;
+    uint8_t source = record->type >> 4;
+
+    if(synced) printf("%10lu ms  ", (unsigned long)(((uint32_t)high << 16) | record->time));
+    else printf("   ?+%5u ms  ", record->time);
+    printf("roleta %u  ", source);
+
+    switch (type)
+    {
+    case TRACE_STATE:
+        printf("estado     %s -> %s\n", stateName(record->value), stateName(record->arg));
+        break;
+    case TRACE_FRAME:
+        // Com mais de 32 leds, cada palavra do quadro vem em um registro, com o primeiro led indicado
+        if(record->arg == 0) printf("quadro     ");
+        else printf("quadro+%-4u", record->arg * 32);
+        for (int8_t bit = 31; bit >= 0; bit--)
+        {
+            putchar((record->value >> bit) & 1 ? '1' : '0');
+        }
+        printf(" (0x%08lx)\n", (unsigned long)record->value);
+        break;
+    case TRACE_BUTTON:
+        printf("botão      %s pressionado em %lu ms%s\n",
+            (record->arg & ~TRACE_BUTTON_BOUNCE) == 0x02 ? "iniciar" : "preparar",
+            (unsigned long)record->value,
+            record->arg & TRACE_BUTTON_BOUNCE ? " (trepidação, descartado)" : "");
+        break;
+    case TRACE_DRAW_START:
+        if(record->value == 0xFFFFFFFF) printf("sorteio    início, led %u, giro sem fim\n", record->arg);
+        else printf("sorteio    início, led %u, giro previsto de %lu ms\n", record->arg, (unsigned long)record->value);
+        break;
+    case TRACE_DRAW_RESULT:
+        printf("sorteio    resultado: led %u (sorteio nº %lu)\n", record->arg, (unsigned long)record->value);
+        break;
+    default:
+        printf("tipo %u    arg %u valor %lu\n", type, record->arg, (unsigned long)record->value);
+        break;
+    }
+}
+
+/**
+ * @brief Decodifica a transmissão que começa após TRACE_MAGIC
+ * 
+ * @param input Arquivo de entrada
+ * @return true Se a transmissão foi lida por completo
+ */
+bool decodeDump(FILE *input){
+    int count = fgetc(input);
+    uint16_t high = 0;
+    bool synced = false;
+    trace_record_t record;
+
+    if(count == EOF) return false;
+    printf("--- %d registros\n", count);
+
+    for (int i = 0; i < count; i++)
+    {
+        if(!readRecord(input, &record)){
+            printf("--- transmissão incompleta\n");
+            return false;
+        }
+        if((record.type & TRACE_TYPE_MASK) == TRACE_SYNC){
+            high = record.value >> 16;
+            synced = true;
+            continue;
+        }
+        printRecord(&record, high, synced);
+    }
+    return true;
+}
+
+int main(int argc, char **argv){
+    FILE *input = argc > 1 ? fopen(argv[1], "rb") : stdin;
+    const char *magic = TRACE_MAGIC;
+    size_t matched = 0;
+    int c;
+
+    if(input == NULL){
+        perror(argv[1]);
+        return 1;
+    }
+
+    while ((c = fgetc(input)) != EOF)
+    {
+        if(c == magic[matched]){
+            if(++matched < strlen(magic)) continue;
+            matched = 0;
+            decodeDump(input);
+        }else{
+            matched = c == magic[0] ? 1 : 0;
+        }
+    }
+
+    if(input != stdin) fclose(input);
+    return 0;
+}